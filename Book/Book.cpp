@@ -1,11 +1,16 @@
 #include "Book.hpp"
+#include "RecordFormats.hpp"
+#include "Stats/Memory.hpp"
 #include <iostream>
 #include <ostream>
 #include <stdexcept>
 #include <utility>
 
+int Book::nextId = 1;
+
 Book::Book(std::string title, std::string author, const Genre genre)
-    : title(std::move(title))
+    : id(nextId++)
+    , title(std::move(title))
     , author(std::move(author))
     , genre(genre)
     , status(BookStatus::Available)
@@ -13,15 +18,38 @@ Book::Book(std::string title, std::string author, const Genre genre)
     , dueDate(std::nullopt)
     , currentPatronId(std::nullopt) {}
 
-void Book::checkout(const int patronId) {
+// Same idea as Patron IDs: explicit IDs from the file push the counter past them
+void Book::setId(const int newId) {
+    if (newId < 1 || newId > MAX_ID) throw std::out_of_range("Book ID out of range: " + std::to_string(newId));
+    id = newId;
+    if (newId >= nextId) nextId = newId + 1;
+}
+
+void Book::copyDetailsFrom(const Book& other) {
+    title = other.title;
+    author = other.author;
+    genre = other.genre;
+}
+
+void Book::copyStateFrom(const Book& other) {
+    status = other.status;
+    checkoutDate = other.checkoutDate;
+    dueDate = other.dueDate;
+    currentPatronId = other.currentPatronId;
+}
+
+void Book::checkout(const int patronId, const Date& on) {
     status = BookStatus::CheckedOut;
     currentPatronId = patronId;
-    checkoutDate = Date();
+    checkoutDate = on;
     dueDate = checkoutDate->addDays(30);
 }
 
 void Book::returnBook() {
+    // Dates go too, a reload never reads them back for an available book and replicas start from a reload
     status = BookStatus::Available;
+    checkoutDate = std::nullopt;
+    dueDate = std::nullopt;
     currentPatronId = std::nullopt;
 }
 
@@ -43,32 +71,10 @@ void Book::displayInfo() const {
               << genreToString(getGenre()) << " [" << bookStatusToString(getStatus()) << "]" << std::endl;
 }
 
-std::string Book::genreToString(const Genre g) {
-    switch (g) {
-        case Genre::Fiction: return "Fiction";
-        case Genre::NonFiction: return "Non-Fiction";
-        case Genre::Mystery: return "Mystery";
-        case Genre::Science: return "Science";
-        case Genre::Biography: return "Biography";
-        default: return "Unknown";
-    }
-}
-
-std::string Book::bookStatusToString(const BookStatus s) {
-    switch (s) {
-        case BookStatus::Available: return "Available";
-        case BookStatus::CheckedOut: return "Checked Out";
-        default: return "Unknown";
-    }
-}
-
-Book::Genre Book::stringToGenre(const std::string& s) {
-    if (s == "Fiction") return Genre::Fiction;
-    if (s == "Non-Fiction") return Genre::NonFiction;
-    if (s == "Mystery") return Genre::Mystery;
-    if (s == "Science") return Genre::Science;
-    if (s == "Biography") return Genre::Biography;
-    throw std::invalid_argument("Invalid genre string: " + s);
+Book::Genre Book::stringToGenre(const std::string_view s) {
+    Genre genre;
+    if (!Schema::EnumDecoder<Genre>::decode(s, genre)) throw std::invalid_argument("Invalid genre string: " + std::string(s));
+    return genre;
 }
 
 bool Book::operator==(const Book& other) const {
@@ -79,4 +85,17 @@ std::ostream& operator<<(std::ostream& os, const Book& b) {
     os << b.title << "," << b.author << "," << Book::genreToString(b.genre)
        << "," << Book::bookStatusToString(b.status);
     return os;
+}
+
+void Book::resetIdCounter(const int startFrom) { nextId = startFrom; }
+
+void* Book::operator new(const std::size_t size) {
+    void* p = ::operator new(size);
+    Memory::allocated(Memory::Pool::BookObjects, size);
+    return p;
+}
+
+void Book::operator delete(void* p, const std::size_t size) {
+    Memory::freed(Memory::Pool::BookObjects, size);
+    ::operator delete(p, size);
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #ifndef FINAL_PROJECT_BOOK_H
 #define FINAL_PROJECT_BOOK_H
 
+#include <array>
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <optional>
 #include "Transaction/Date.hpp"
@@ -11,7 +14,11 @@ public:
     enum class Genre { Fiction, NonFiction, Mystery, Science, Biography };
     enum class BookStatus { Available, CheckedOut };
 
+    // IDs index a dense table (Library::bookRowsById), anything bigger is a typo in Books.txt, not a book
+    static constexpr int MAX_ID = 1 << 24;
+
 protected:
+    int id;
     std::string title;
     std::string author;
     Genre genre;
@@ -21,10 +28,17 @@ protected:
     std::optional<Date> dueDate;
     std::optional<int> currentPatronId;
 
+    static int nextId;
+
 public:
     Book(std::string title, std::string author, Genre genre);
     virtual ~Book() = default;
 
+    // Counted in Memory::Pool::BookObjects. The virtual destructor means delete gets the
+    // subclass's real size, so EBooks and PrintedBooks are counted exactly.
+    static void* operator new(std::size_t size);
+    static void operator delete(void* p, std::size_t size);
+
     virtual void displayInfo() const;
     virtual std::string getType() { return "Unknown"; }
 
@@ -32,16 +46,21 @@ public:
     void setCheckoutDate(const Date& date) { checkoutDate = date; }
     void setDueDate(const Date& date) { dueDate = date; }
     void setCurrentPatronId(int id) { currentPatronId = id; }
+    void setId(int newId);  // Throws std::out_of_range outside 1..MAX_ID
+    // For applying an edited Books.txt line to the book already in memory
+    void copyDetailsFrom(const Book& other);  // Title, author and genre
+    void copyStateFrom(const Book& other);    // Status, dates and borrower
 
-    void checkout(int patronId);
+    void checkout(int patronId, const Date& on = Date());
     void returnBook();
 
+    [[nodiscard]] int getId() const { return id; }
     [[nodiscard]] BookStatus getStatus() const { return status; };
-    [[nodiscard]] std::string getTitle() const { return title; }
-    [[nodiscard]] std::string getAuthor() const { return author; }
+    [[nodiscard]] const std::string& getTitle() const { return title; }
+    [[nodiscard]] const std::string& getAuthor() const { return author; }
     [[nodiscard]] Genre getGenre() const { return genre; }
-    [[nodiscard]] std::optional<Date> getCheckoutDate() const { return checkoutDate; }
-    [[nodiscard]] std::optional<Date> getDueDate() const { return dueDate; }
+    [[nodiscard]] const std::optional<Date>& getCheckoutDate() const { return checkoutDate; }
+    [[nodiscard]] const std::optional<Date>& getDueDate() const { return dueDate; }
     [[nodiscard]] std::optional<int> getCurrentPatronId() const { return currentPatronId; }
     [[nodiscard]] bool isOverdue() const;
     [[nodiscard]] int getDaysOverdue() const;
@@ -49,9 +68,20 @@ public:
     bool operator==(const Book& other) const;
     friend std::ostream& operator<<(std::ostream& os, const Book& b);
 
-    static std::string genreToString(Genre g);
-    static std::string bookStatusToString(BookStatus s);
-    static Genre stringToGenre(const std::string& s);
+    static constexpr std::array<std::string_view, 5> GENRE_NAMES{"Fiction", "Non-Fiction", "Mystery", "Science", "Biography"};
+    static constexpr std::array<std::string_view, 2> STATUS_NAMES{"Available", "Checked Out"};
+
+    [[nodiscard]] static constexpr std::string_view genreToString(const Genre g) {
+        const auto i = static_cast<std::size_t>(g);
+        return i < GENRE_NAMES.size() ? GENRE_NAMES[i] : "Unknown";
+    }
+    [[nodiscard]] static constexpr std::string_view bookStatusToString(const BookStatus s) {
+        const auto i = static_cast<std::size_t>(s);
+        return i < STATUS_NAMES.size() ? STATUS_NAMES[i] : "Unknown";
+    }
+    // Throws std::invalid_argument if it's not a genre
+    static Genre stringToGenre(std::string_view s);
+    static void resetIdCounter(int startFrom = 1);
 };
 
 #endif
\ No newline at end of file
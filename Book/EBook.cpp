@@ -1,7 +1,8 @@
 #include "EBook.hpp"
+#include <utility>
 
-EBook::EBook(const std::string &title, const std::string &author, const Genre genre, const double size)
-    : Book(title, author, genre), fileSizeMB(size) {}
+EBook::EBook(std::string title, std::string author, const Genre genre, const double size)
+    : Book(std::move(title), std::move(author), genre), fileSizeMB(size) {}
 
 void EBook::displayInfo() const {
     std::cout << "[E-Book] " << getTitle() << " - " << getAuthor() << ", "
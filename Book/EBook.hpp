@@ -9,7 +9,7 @@ private:
     double fileSizeMB;
 
 public:
-    EBook(const std::string &title, const std::string &author, Genre genre, double size);
+    EBook(std::string title, std::string author, Genre genre, double size);
 
     void displayInfo() const override;
 
@@ -1,7 +1,8 @@
 #include "PrintedBook.hpp"
+#include <utility>
 
-PrintedBook::PrintedBook(const std::string &title, const std::string &author, const Genre genre, const int pages)
-    : Book(title, author, genre), pageCount(pages) {}
+PrintedBook::PrintedBook(std::string title, std::string author, const Genre genre, const int pages)
+    : Book(std::move(title), std::move(author), genre), pageCount(pages) {}
 
 void PrintedBook::displayInfo() const {
     std::cout << "[Printed] " << getTitle() << " - " << getAuthor() << ", "
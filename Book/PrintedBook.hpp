@@ -8,7 +8,7 @@ private:
     int pageCount;
 
 public:
-    PrintedBook(const std::string &title, const std::string &author, Genre genre, int pages);
+    PrintedBook(std::string title, std::string author, Genre genre, int pages);
 
     void displayInfo() const override;
     std::string getType() override { return "Printed Book: " + std::to_string(pageCount) + " pages"; }
@@ -0,0 +1,167 @@
+#include "BookTableModel.hpp"
+#include <algorithm>
+
+BookTableModel::BookTableModel(Library* lib, QObject* parent)
+    : QAbstractTableModel(parent)
+    , library(lib) {
+    library->addListener(this);
+}
+
+BookTableModel::~BookTableModel() {
+    library->removeListener(this);
+}
+
+int BookTableModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return static_cast<int>(showingAll ? library->getBooks().size() : rows.size());
+}
+
+int BookTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant BookTableModel::data(const QModelIndex& index, const int role) const {
+    if (!index.isValid() || role != Qt::DisplayRole) return {};
+
+    Book* book = bookAt(index.row());
+    if (!book) return {};
+
+    switch (index.column()) {
+        case TitleColumn: return QString::fromStdString(book->getTitle());
+        case AuthorColumn: return QString::fromStdString(book->getAuthor());
+        case GenreColumn: {
+            const std::string_view genre = Book::genreToString(book->getGenre());
+            return QString::fromUtf8(genre.data(), static_cast<qsizetype>(genre.size()));
+        }
+        case TypeColumn: return QString::fromStdString(book->getType());
+        case StatusColumn: return statusText(book);
+        default: return {};
+    }
+}
+
+QVariant BookTableModel::headerData(const int section, const Qt::Orientation orientation, const int role) const {
+    if (role != Qt::DisplayRole) return {};
+    if (orientation == Qt::Vertical) return section + 1;
+
+    switch (section) {
+        case TitleColumn: return "Title";
+        case AuthorColumn: return "Author";
+        case GenreColumn: return "Genre";
+        case TypeColumn: return "Type";
+        case StatusColumn: return "Status";
+        default: return {};
+    }
+}
+
+bool BookTableModel::canFetchMore(const QModelIndex& parent) const {
+    return !parent.isValid() && !showingAll && moreAvailable;
+}
+
+void BookTableModel::fetchMore(const QModelIndex& parent) {
+    if (!canFetchMore(parent)) return;
+    moreAvailable = false;  // Set again when the next page arrives
+    emit moreRequested();
+}
+
+void BookTableModel::showAll() {
+    beginResetModel();
+    showingAll = true;
+    moreAvailable = false;
+    rows.clear();
+    endResetModel();
+}
+
+void BookTableModel::showBooks(std::vector<Book*> results) {
+    beginResetModel();
+    showingAll = false;
+    moreAvailable = false;
+    rows = std::move(results);
+    endResetModel();
+}
+
+void BookTableModel::appendBooks(const std::vector<Book*>& more) {
+    if (showingAll || more.empty()) return;
+
+    const int first = static_cast<int>(rows.size());
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(more.size()) - 1);
+    rows.insert(rows.end(), more.begin(), more.end());
+    endInsertRows();
+}
+
+Book* BookTableModel::bookAt(const int row) const {
+    if (row < 0) return nullptr;
+
+    const auto& source = showingAll ? library->getBooks() : rows;
+    return static_cast<std::size_t>(row) < source.size() ? source[row] : nullptr;
+}
+
+QString BookTableModel::statusText(const Book* book) const {
+    QString text;
+    if (book->getStatus() == Book::BookStatus::Available) text = "Available";
+    else if (book->isOverdue()) text = "Checked Out - OVERDUE!";
+    else text = "Checked Out";
+
+    // Counted by the inventory, the other copies aren't looked at
+    const CopyCount copies = library->copiesOf(book);
+    if (copies.total > 1) text += QString(" (%1 of %2 available)").arg(copies.available).arg(copies.total);
+
+    if (const std::size_t waiting = library->holdsOn(book)) text += QString(" - %1 on hold").arg(waiting);
+    return text;
+}
+
+void BookTableModel::bookChanged(const std::size_t row) {
+    int viewRow = static_cast<int>(row);
+
+    if (!showingAll) {
+        // Search results are usually a handful of rows, the catalog isn't touched
+        const Book* book = library->getBooks()[row];
+        const auto it = std::ranges::find(rows, book);
+        if (it == rows.end()) return;
+        viewRow = static_cast<int>(it - rows.begin());
+    }
+
+    emit dataChanged(index(viewRow, 0), index(viewRow, ColumnCount - 1));
+}
+
+void BookTableModel::bookAppended(const std::size_t row) {
+    // New books only show up in the full catalog, search results stay as they were
+    if (!showingAll) return;
+
+    beginInsertRows(QModelIndex(), static_cast<int>(row), static_cast<int>(row));
+    endInsertRows();
+}
+
+void BookTableModel::booksAppended(const std::size_t first, const std::size_t count) {
+    // One insert per loader batch rather than per book
+    if (!showingAll || count == 0) return;
+
+    beginInsertRows(QModelIndex(), static_cast<int>(first), static_cast<int>(first + count - 1));
+    endInsertRows();
+}
+
+void BookTableModel::booksReset() {
+    // Books were reloaded, any Book* we held for search results is gone
+    showAll();
+}
+
+void BookFilterProxyModel::setFilter(const Filter f) {
+    if (f == filter) return;
+    filter = f;
+    invalidateFilter();
+}
+
+bool BookFilterProxyModel::filterAcceptsRow(const int sourceRow, const QModelIndex& sourceParent) const {
+    if (filter == Filter::All) return true;
+
+    const auto* model = static_cast<const BookTableModel*>(sourceModel());
+    const Book* book = model->bookAt(sourceRow);
+    if (!book) return false;
+
+    switch (filter) {
+        case Filter::Available: return book->getStatus() == Book::BookStatus::Available;
+        case Filter::CheckedOut: return book->getStatus() == Book::BookStatus::CheckedOut;
+        case Filter::Printed: return dynamic_cast<const PrintedBook*>(book) != nullptr;
+        case Filter::EBook: return dynamic_cast<const EBook*>(book) != nullptr;
+        default: return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef BOOKTABLEMODEL_H
+#define BOOKTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QSortFilterProxyModel>
+#include <vector>
+#include "Library.hpp"
+
+// Reads straight from Library, so the view only ever touches the rows it's painting.
+// Library changes come in per row, so a checkout repaints one row instead of the whole table.
+class BookTableModel : public QAbstractTableModel, public LibraryListener
+{
+    Q_OBJECT
+
+public:
+    enum Column { TitleColumn, AuthorColumn, GenreColumn, TypeColumn, StatusColumn, ColumnCount };
+
+    explicit BookTableModel(Library* lib, QObject* parent = nullptr);
+    ~BookTableModel() override;
+
+    [[nodiscard]] int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    [[nodiscard]] int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    [[nodiscard]] QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    [[nodiscard]] bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    void showAll();
+    void showBooks(std::vector<Book*> results);
+    void appendBooks(const std::vector<Book*>& more);  // Streamed search results
+    void setMoreAvailable(bool more) { moreAvailable = more; }
+
+    [[nodiscard]] Book* bookAt(int row) const;
+    [[nodiscard]] bool isShowingAll() const { return showingAll; }
+
+    [[nodiscard]] QString statusText(const Book* book) const;
+
+signals:
+    void moreRequested();  // View scrolled to the end of a paged search
+
+public:
+    // LibraryListener
+    void bookChanged(std::size_t row) override;
+    void bookAppended(std::size_t row) override;
+    void booksAppended(std::size_t first, std::size_t count) override;
+    void booksReset() override;
+
+private:
+    Library* library;
+    bool showingAll = true;
+    bool moreAvailable = false;
+    std::vector<Book*> rows;  // Only used for search results, "all" reads the catalog directly
+};
+
+// View menu filters and column sorting sit on top of the model instead of rebuilding rows
+class BookFilterProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    enum class Filter { All, Available, CheckedOut, Printed, EBook };
+
+    explicit BookFilterProxyModel(QObject* parent = nullptr) : QSortFilterProxyModel(parent) {}
+
+    void setFilter(Filter f);
+    [[nodiscard]] Filter getFilter() const { return filter; }
+
+protected:
+    [[nodiscard]] bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+
+private:
+    Filter filter = Filter::All;
+};
+
+#endif
\ No newline at end of file
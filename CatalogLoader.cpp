@@ -0,0 +1,84 @@
+#include "CatalogLoader.hpp"
+#include <QMetaObject>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include "Stats/Trace.hpp"
+
+namespace {
+    qint64 countLines(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        return std::count(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), '\n');
+    }
+}
+
+CatalogLoader::CatalogLoader(Library* library, QObject* parent)
+    : QObject(parent)
+    , library(library)
+    , cancelled(std::make_shared<std::atomic<bool>>(false)) {
+    pool.setMaxThreadCount(1);
+}
+
+CatalogLoader::~CatalogLoader() {
+    cancelled->store(true);
+    pool.waitForDone();
+}
+
+void CatalogLoader::start(const std::string& directory) {
+    if (loading) return;
+    loading = true;
+    library->beginLoading();
+
+    pool.start([this, directory, stop = cancelled]() {
+        Trace::Span span("backgroundLoad", "library", directory);
+        try {
+            auto patrons = Library::readPatrons(directory + "/Patrons.txt");
+            const qint64 total = countLines(directory + "/Books.txt");
+
+            QMetaObject::invokeMethod(this, [this, patrons = std::move(patrons), total]() mutable {
+                library->setPatrons(std::move(patrons));
+                emit progress(0, total);
+            }, Qt::QueuedConnection);
+
+            qint64 loaded = 0;
+            Library::readBooks(directory + "/Books.txt", BATCH_SIZE, [&](std::vector<Book*> batch) {
+                if (stop->load()) {
+                    for (const auto* book : batch) delete book;
+                    return false;
+                }
+
+                loaded += static_cast<qint64>(batch.size());
+                // Held by a shared_ptr so the books are freed even if the window closes before it's delivered
+                auto books = std::shared_ptr<std::vector<Book*>>(new std::vector<Book*>(std::move(batch)),
+                    [](const std::vector<Book*>* pending) {
+                        for (const auto* book : *pending) delete book;
+                        delete pending;
+                    });
+
+                QMetaObject::invokeMethod(this, [this, books, loaded, total]() {
+                    library->appendBooks(*books);
+                    books->clear();  // The Library owns them now
+                    emit progress(loaded, std::max(loaded, total));
+                }, Qt::QueuedConnection);
+                return true;
+            });
+
+            QMetaObject::invokeMethod(this, [this, directory]() {
+                library->finishLoading(directory);
+                loading = false;
+                emit finished(true, {});
+            }, Qt::QueuedConnection);
+        } catch (const std::exception& e) {
+            QMetaObject::invokeMethod(this, [this, directory, error = QString::fromStdString(e.what())]() {
+                fail(directory, error);
+            }, Qt::QueuedConnection);
+        }
+    });
+}
+
+void CatalogLoader::fail(const std::string& directory, const QString& error) {
+    // Keep whatever made it in, same as a failed loadData()
+    library->finishLoading(directory);
+    loading = false;
+    emit finished(false, error);
+}
\ No newline at end of file
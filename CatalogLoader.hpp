@@ -0,0 +1,40 @@
+#ifndef CATALOGLOADER_H
+#define CATALOGLOADER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <string>
+#include "Library.hpp"
+
+// Reads patrons and books on a background thread so the window can show straight away.
+// Books are handed to the Library in batches on the GUI thread, so the table fills in as
+// they arrive. Transactions aren't read here, the Library loads them when first needed.
+class CatalogLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CatalogLoader(Library* library, QObject* parent = nullptr);
+    ~CatalogLoader() override;
+
+    void start(const std::string& directory = "Data");
+    [[nodiscard]] bool isLoading() const { return loading; }
+
+signals:
+    void progress(qint64 booksLoaded, qint64 booksTotal);  // Total is a line count, so roughly
+    void finished(bool ok, const QString& error);
+
+private:
+    static constexpr std::size_t BATCH_SIZE = 500;
+
+    Library* library;
+    QThreadPool pool;
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    bool loading = false;
+
+    void fail(const std::string& directory, const QString& error);
+};
+
+#endif
\ No newline at end of file
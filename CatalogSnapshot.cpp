@@ -0,0 +1,33 @@
+#include "CatalogSnapshot.hpp"
+#include <algorithm>
+#include <cctype>
+#include "Book/EBook.hpp"
+#include "Book/PrintedBook.hpp"
+
+namespace {
+    std::string typeColumnsOf(const Book& book) {
+        if (auto* ebook = dynamic_cast<const EBook*>(&book)) return "EBook|" + std::to_string(ebook->getFileSize());
+        if (auto* printed = dynamic_cast<const PrintedBook*>(&book)) return "PrintedBook|" + std::to_string(printed->getPageCount());
+        return "Unknown|0";
+    }
+}
+
+BookRecord::BookRecord(const Book& book)
+    : id(book.getId())
+    , genre(book.getGenre())
+    , title(book.getTitle())
+    , author(book.getAuthor())
+    , foldedTitle(foldCase(book.getTitle()))
+    , foldedAuthor(foldCase(book.getAuthor()))
+    , typeColumns(typeColumnsOf(book)) {}
+
+BookState::BookState(const Book& book)
+    : status(book.getStatus())
+    , checkoutDate(book.getCheckoutDate())
+    , dueDate(book.getDueDate())
+    , patronId(book.getCurrentPatronId()) {}
+
+std::string foldCase(std::string s) {
+    std::ranges::transform(s, s.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
\ No newline at end of file
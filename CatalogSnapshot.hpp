@@ -0,0 +1,77 @@
+#ifndef FINAL_PROJECT_CATALOGSNAPSHOT_HPP
+#define FINAL_PROJECT_CATALOGSNAPSHOT_HPP
+
+#include <memory>
+#include <optional>
+#include <string>
+#include "Book/Book.hpp"
+#include "Transaction/Transaction.hpp"
+#include "Transaction/TransactionLog.hpp"
+#include "ChunkedVector.hpp"
+#include "Stats/Memory.hpp"
+
+class FuzzyIndex;
+
+// Immutable copy of the fixed book fields. Once handed out it never changes,
+// so worker threads can read it while the GUI thread keeps mutating Library.
+struct BookRecord {
+    int id;
+    Book::Genre genre;
+    std::string title;
+    std::string author;
+    std::string foldedTitle;   // Lowercased once here instead of on every search
+    std::string foldedAuthor;
+    std::string typeColumns;   // "EBook|5.832000" etc, the type-specific columns of Books.txt
+
+    explicit BookRecord(const Book& book);
+};
+
+// The part of a book that checkouts change, kept apart so updating it doesn't copy strings
+struct BookState {
+    Book::BookStatus status;
+    std::optional<Date> checkoutDate;
+    std::optional<Date> dueDate;
+    std::optional<int> patronId;
+
+    explicit BookState(const Book& book);
+};
+
+struct PatronRecord {
+    int id;
+    std::string name;
+};
+
+struct HoldRecord {
+    int patronId;
+    std::string title;
+};
+
+/* Point-in-time copy of everything that gets saved. Library keeps the live one and
+ * hands out copies, which share all chunks the live one hasn't written to since, so
+ * taking one is cheap and saves/reports can run on another thread.
+ * books and bookStates rows line up with Library::getBooks(). */
+using HoldList = Memory::Vector<HoldRecord, Memory::Pool::Snapshot>;
+
+template<typename T>
+using SnapshotVector = ChunkedVector<T, 64, Memory::Allocator<T, Memory::Pool::Snapshot>>;
+
+struct CatalogSnapshot {
+    SnapshotVector<BookRecord> books;
+    SnapshotVector<BookState> bookStates;
+    SnapshotVector<PatronRecord> patrons;
+    TransactionList transactions;
+    // False until the log is read, an unloaded log must never be written over the real one
+    bool transactionsLoaded = true;
+
+    // Every hold queue, oldest first within a title. Rebuilt as a whole the first time a
+    // snapshot is taken after a hold changes, holds don't change often enough to chunk.
+    std::shared_ptr<const HoldList> holds;
+
+    // Trigram indexes over titles and authors, shared with Library until it next adds a book
+    std::shared_ptr<const FuzzyIndex> fuzzyTitles;
+    std::shared_ptr<const FuzzyIndex> fuzzyAuthors;
+};
+
+std::string foldCase(std::string s);
+
+#endif
\ No newline at end of file
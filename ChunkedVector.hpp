@@ -0,0 +1,112 @@
+#ifndef FINAL_PROJECT_CHUNKEDVECTOR_HPP
+#define FINAL_PROJECT_CHUNKEDVECTOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/* Vector split into fixed-size chunks that copies share. Copying one only copies the
+ * chunk pointers (size / ChunkSize of them), and a write clones just the chunk it
+ * touches if a copy still holds it. That makes copies cheap point-in-time versions:
+ * the owner keeps writing while other threads read their copy.
+ *
+ * Only one thread may write to (or copy) a given ChunkedVector, readers get their own copy.
+ * Alloc (stateless) is used for the chunks, their shared_ptr control blocks and the chunk table. */
+template<typename T, std::size_t ChunkSize = 64, typename Alloc = std::allocator<T>>
+class ChunkedVector {
+    static_assert((ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+private:
+    template<typename U>
+    using Rebind = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+    using Chunk = std::vector<T, Alloc>;
+
+    std::vector<std::shared_ptr<Chunk>, Rebind<std::shared_ptr<Chunk>>> chunks;
+    std::size_t count = 0;
+
+    static std::shared_ptr<Chunk> newChunk() {
+        auto chunk = std::allocate_shared<Chunk>(Rebind<Chunk>());
+        chunk->reserve(ChunkSize);
+        return chunk;
+    }
+
+    // Clones the chunk first if some copy can still see it
+    Chunk& writable(const std::size_t index) {
+        auto& chunk = chunks[index];
+        if (chunk.use_count() > 1) {
+            auto copy = newChunk();
+            copy->assign(chunk->begin(), chunk->end());
+            chunk = std::move(copy);
+        } else {
+            // Pairs with the release in the reader's shared_ptr destructor, their reads finish before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *chunk;
+    }
+
+    Chunk& tail() {
+        if (count % ChunkSize == 0) {
+            chunks.push_back(newChunk());
+            return *chunks.back();
+        }
+        return writable(chunks.size() - 1);
+    }
+
+public:
+    using value_type = T;
+
+    class const_iterator {
+    private:
+        const ChunkedVector* owner = nullptr;
+        std::size_t index = 0;
+
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = const T&;
+        using pointer = const T*;
+        using iterator_category = std::forward_iterator_tag;
+
+        const_iterator() = default;
+        const_iterator(const ChunkedVector* owner, const std::size_t index) : owner(owner), index(index) {}
+
+        reference operator*() const { return (*owner)[index]; }
+        pointer operator->() const { return &(*owner)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++index; return old; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+    };
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    const T& operator[](const std::size_t i) const { return (*chunks[i / ChunkSize])[i % ChunkSize]; }
+    [[nodiscard]] const T& back() const { return (*this)[count - 1]; }
+
+    [[nodiscard]] const_iterator begin() const { return {this, 0}; }
+    [[nodiscard]] const_iterator end() const { return {this, count}; }
+
+    void reserve(const std::size_t n) { chunks.reserve((n + ChunkSize - 1) / ChunkSize); }
+
+    void push_back(T value) { emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args) {
+        tail().emplace_back(std::forward<Args>(args)...);
+        count++;
+    }
+
+    void set(const std::size_t i, T value) { writable(i / ChunkSize)[i % ChunkSize] = std::move(value); }
+
+    // Copies keep their chunks, this one just lets go of them
+    void clear() {
+        chunks.clear();
+        count = 0;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "BookIndexes.hpp"
+#include "Book/EBook.hpp"
+#include "Book/PrintedBook.hpp"
+
+void BookIndexes::clear() {
+    for (auto& rows : genreRows) rows.clear();
+    for (auto& rows : kindRows) rows.clear();
+    checkedOutRows.clear();
+    checkedOutSlot.clear();
+}
+
+void BookIndexes::add(const std::size_t row, const Book& book) {
+    genreRows[static_cast<std::size_t>(book.getGenre())].push_back(row);
+    kindRows[static_cast<std::size_t>(kindOf(book))].push_back(row);
+
+    if (row >= checkedOutSlot.size()) checkedOutSlot.resize(row + 1, NOT_CHECKED_OUT);
+    setCheckedOut(row, book.getStatus() == Book::BookStatus::CheckedOut);
+}
+
+void BookIndexes::setCheckedOut(const std::size_t row, const bool checkedOut) {
+    std::size_t& slot = checkedOutSlot[row];
+
+    if (checkedOut && slot == NOT_CHECKED_OUT) {
+        slot = checkedOutRows.size();
+        checkedOutRows.push_back(row);
+    } else if (!checkedOut && slot != NOT_CHECKED_OUT) {
+        // Swap with the last entry so removal doesn't shift anything
+        const std::size_t last = checkedOutRows.back();
+        checkedOutRows[slot] = last;
+        checkedOutSlot[last] = slot;
+        checkedOutRows.pop_back();
+        slot = NOT_CHECKED_OUT;
+    }
+}
+
+BookKind BookIndexes::kindOf(const Book& book) {
+    if (dynamic_cast<const PrintedBook*>(&book)) return BookKind::Printed;
+    if (dynamic_cast<const EBook*>(&book)) return BookKind::EBook;
+    return BookKind::Other;
+}
\ No newline at end of file
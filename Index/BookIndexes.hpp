@@ -0,0 +1,41 @@
+#ifndef FINAL_PROJECT_BOOKINDEXES_HPP
+#define FINAL_PROJECT_BOOKINDEXES_HPP
+
+#include <array>
+#include <cstddef>
+#include "Book/Book.hpp"
+#include "Stats/Memory.hpp"
+
+enum class BookKind { Printed, EBook, Other };
+
+// Secondary indexes by catalog row, used by the query planner to avoid full scans.
+// Genre and type lists are append-only and stay in row order; the checked-out set
+// supports O(1) insert/remove so checkouts stay cheap.
+class BookIndexes {
+public:
+    static constexpr std::size_t GENRE_COUNT = 5;
+    static constexpr std::size_t KIND_COUNT = 3;
+
+    using Rows = Memory::Vector<std::size_t, Memory::Pool::Indexes>;
+
+private:
+    static constexpr std::size_t NOT_CHECKED_OUT = static_cast<std::size_t>(-1);
+
+    std::array<Rows, GENRE_COUNT> genreRows;
+    std::array<Rows, KIND_COUNT> kindRows;
+    Rows checkedOutRows;
+    Rows checkedOutSlot;  // Row -> position in checkedOutRows
+
+public:
+    void clear();
+    void add(std::size_t row, const Book& book);
+    void setCheckedOut(std::size_t row, bool checkedOut);
+
+    [[nodiscard]] const Rows& rowsWithGenre(Book::Genre g) const { return genreRows[static_cast<std::size_t>(g)]; }
+    [[nodiscard]] const Rows& rowsOfKind(BookKind k) const { return kindRows[static_cast<std::size_t>(k)]; }
+    [[nodiscard]] const Rows& checkedOut() const { return checkedOutRows; }
+
+    static BookKind kindOf(const Book& book);
+};
+
+#endif
\ No newline at end of file
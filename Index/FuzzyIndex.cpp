@@ -0,0 +1,121 @@
+#include "FuzzyIndex.hpp"
+#include <algorithm>
+#include <array>
+#include "CatalogSnapshot.hpp"
+
+int fuzzySubstringDistance(const std::string_view pattern, const std::string_view text) {
+    const std::size_t m = std::min<std::size_t>(pattern.size(), 64);
+    if (m == 0) return 0;
+
+    std::array<std::uint64_t, 256> peq{};
+    for (std::size_t i = 0; i < m; ++i) peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t{1} << i;
+
+    const std::uint64_t highBit = std::uint64_t{1} << (m - 1);
+    std::uint64_t pv = ~std::uint64_t{0};
+    std::uint64_t mv = 0;
+    int score = static_cast<int>(m);
+    int best = score;
+
+    for (const char c : text) {
+        const std::uint64_t eq = peq[static_cast<unsigned char>(c)];
+        const std::uint64_t xv = eq | mv;
+        const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+
+        if (ph & highBit) score++;
+        else if (mh & highBit) score--;
+
+        // The match may start anywhere in the text, so row 0 stays at 0 (shift in nothing)
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        best = std::min(best, score);
+    }
+
+    return best;
+}
+
+std::vector<std::uint32_t> FuzzyIndex::trigrams(const std::string_view folded) {
+    std::vector<std::uint32_t> grams;
+    if (folded.size() < 3) return grams;
+
+    grams.reserve(folded.size() - 2);
+    for (std::size_t i = 0; i + 3 <= folded.size(); ++i) {
+        grams.push_back(static_cast<std::uint32_t>(static_cast<unsigned char>(folded[i])) << 16
+                      | static_cast<std::uint32_t>(static_cast<unsigned char>(folded[i + 1])) << 8
+                      | static_cast<unsigned char>(folded[i + 2]));
+    }
+    std::ranges::sort(grams);
+    grams.erase(std::ranges::unique(grams).begin(), grams.end());
+    return grams;
+}
+
+void FuzzyIndex::add(const std::string& text, const int bookId) {
+    const auto entry = static_cast<std::uint32_t>(texts.size());
+    texts.emplace_back(foldCase(text));
+    bookIds.push_back(bookId);
+
+    for (const std::uint32_t gram : trigrams(texts.back())) postings[gram].push_back(entry);
+}
+
+void FuzzyIndex::clear() {
+    texts.clear();
+    bookIds.clear();
+    postings.clear();
+}
+
+std::vector<FuzzyMatch> FuzzyIndex::search(const std::string& query, const std::size_t limit,
+                                           const std::function<bool()>& cancelled) const {
+    std::vector<FuzzyMatch> matches;
+    const std::string folded = foldCase(query).substr(0, 64);
+    const auto grams = trigrams(folded);
+    if (grams.empty() || limit == 0) return matches;
+
+    // Counted against the query's distinct trigrams, a repeated one can only be shared once. Every
+    // match has to share at least one, or it would never be looked at, which caps the typos of short queries.
+    const int distinct = static_cast<int>(grams.size());
+    const int maxEdits = std::min(std::max(1, static_cast<int>(folded.size()) / 4), (distinct - 1) / 3);
+    const int needed = distinct - 3 * maxEdits;
+
+    // Count shared trigrams per entry, only entries that share at least one are touched
+    std::vector<std::uint16_t> shared(texts.size(), 0);
+    std::vector<std::uint32_t> touched;
+    for (const std::uint32_t gram : grams) {
+        const auto it = postings.find(gram);
+        if (it == postings.end()) continue;
+        for (const std::uint32_t entry : it->second) {
+            if (shared[entry]++ == 0) touched.push_back(entry);
+        }
+    }
+
+    std::vector<std::vector<std::uint32_t>> bySharedCount(distinct + 1);
+    for (const std::uint32_t entry : touched) {
+        if (shared[entry] >= needed) bySharedCount[shared[entry]].push_back(entry);
+    }
+
+    // Most shared trigrams first. An entry sharing s of them is at least (distinct - s) / 3 edits
+    // away, so once there are limit matches closer than that, nothing further down can make the cut.
+    std::vector<std::size_t> closerThan(maxEdits + 2, 0);  // Matches at distance < d
+    std::size_t verified = 0;
+    for (int count = distinct; count >= needed; --count) {
+        const int closest = (distinct - count + 2) / 3;
+        if (closest > maxEdits || closerThan[closest] >= limit) break;
+
+        for (const std::uint32_t entry : bySharedCount[count]) {
+            if (cancelled && (++verified & 1023) == 0 && cancelled()) return {};
+            const int distance = fuzzySubstringDistance(folded, texts[entry]);
+            if (distance > maxEdits) continue;
+            matches.push_back({bookIds[entry], distance});
+            for (int d = distance + 1; d <= maxEdits + 1; ++d) closerThan[d]++;
+        }
+    }
+
+    std::ranges::sort(matches, [](const FuzzyMatch& a, const FuzzyMatch& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.bookId < b.bookId;
+    });
+    if (matches.size() > limit) matches.resize(limit);
+    return matches;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef FINAL_PROJECT_FUZZYINDEX_HPP
+#define FINAL_PROJECT_FUZZYINDEX_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Stats/Memory.hpp"
+
+struct FuzzyMatch {
+    int bookId;
+    int distance;
+};
+
+// Smallest edit distance between pattern and any substring of text (Myers' bit-parallel
+// algorithm, one 64-bit word). Patterns longer than 64 characters are cut to 64.
+int fuzzySubstringDistance(std::string_view pattern, std::string_view text);
+
+/* Typo-tolerant lookup. A trigram inverted index narrows the catalog down to entries
+ * sharing enough trigrams with the query (q-gram lemma: m-2 grams, each edit breaks
+ * at most 3), and only those get the edit-distance check.
+ * Library shares its indexes with snapshots and copies one before changing it while a
+ * snapshot still holds it, so a const FuzzyIndex is safe to search from any thread. */
+class FuzzyIndex {
+private:
+    static constexpr auto POOL = Memory::Pool::Indexes;
+
+    Memory::Vector<Memory::String<POOL>, POOL> texts;  // Case-folded
+    Memory::Vector<int, POOL> bookIds;
+    Memory::HashMap<std::uint32_t, Memory::Vector<std::uint32_t, POOL>, POOL> postings;  // Trigram -> entries
+
+    static std::vector<std::uint32_t> trigrams(std::string_view folded);
+
+public:
+    void add(const std::string& text, int bookId);
+    void clear();
+
+    // Closest matches first, allowing roughly one typo per four characters, fewer in short queries
+    // since a match must still share a trigram. Empty if cancelled.
+    [[nodiscard]] std::vector<FuzzyMatch> search(const std::string& query, std::size_t limit,
+                                                 const std::function<bool()>& cancelled = {}) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "HoldQueues.hpp"
+
+std::uint64_t HoldQueues::key(const int titleId, const int patronId) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(titleId)) << 32 | static_cast<std::uint32_t>(patronId);
+}
+
+void HoldQueues::push(const int titleId, const int patronId) {
+    if (titleId < 0) return;
+    if (static_cast<std::size_t>(titleId) >= queues.size()) queues.resize(titleId + 1);
+
+    std::uint32_t n;
+    if (freeNodes != NIL) {
+        n = freeNodes;
+        freeNodes = nodes[n].next;
+        nodes[n] = {patronId, NIL};
+    } else {
+        n = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back({patronId, NIL});
+    }
+
+    Queue& q = queues[titleId];
+    if (q.tail != NIL) nodes[q.tail].next = n;
+    else q.head = n;
+    q.tail = n;
+    q.length++;
+
+    waiting.insert(key(titleId, patronId));
+}
+
+std::optional<int> HoldQueues::pop(const int titleId) {
+    if (titleId < 0 || static_cast<std::size_t>(titleId) >= queues.size()) return std::nullopt;
+
+    Queue& q = queues[titleId];
+    if (q.head == NIL) return std::nullopt;
+
+    const std::uint32_t n = q.head;
+    const int patronId = nodes[n].patronId;
+
+    q.head = nodes[n].next;
+    if (q.head == NIL) q.tail = NIL;
+    q.length--;
+
+    nodes[n].next = freeNodes;
+    freeNodes = n;
+
+    waiting.erase(key(titleId, patronId));
+    return patronId;
+}
+
+void HoldQueues::clear() {
+    nodes.clear();
+    freeNodes = NIL;
+    queues.clear();
+    waiting.clear();
+}
+
+std::size_t HoldQueues::length(const int titleId) const {
+    if (titleId < 0 || static_cast<std::size_t>(titleId) >= queues.size()) return 0;
+    return queues[titleId].length;
+}
\ No newline at end of file
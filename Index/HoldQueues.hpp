@@ -0,0 +1,61 @@
+#ifndef FINAL_PROJECT_HOLDQUEUES_HPP
+#define FINAL_PROJECT_HOLDQUEUES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "Stats/Memory.hpp"
+
+/* Per-title FIFO of patrons waiting for a copy. Every queue lives in one shared node pool
+ * as a singly linked list (head/tail/length per title, freed nodes are reused), so a hold
+ * costs 8 bytes and push, pop and "is this patron already waiting" are all O(1).
+ * Titles are identified by their title ID (see Library::titleIdOf). */
+class HoldQueues {
+private:
+    static constexpr std::uint32_t NIL = static_cast<std::uint32_t>(-1);
+
+    struct Node {
+        int patronId;
+        std::uint32_t next;
+    };
+
+    struct Queue {
+        std::uint32_t head = NIL;
+        std::uint32_t tail = NIL;
+        std::uint32_t length = 0;
+    };
+
+    static constexpr auto POOL = Memory::Pool::Indexes;
+
+    Memory::Vector<Node, POOL> nodes;
+    std::uint32_t freeNodes = NIL;  // Popped nodes, chained through next
+    Memory::Vector<Queue, POOL> queues;  // Title ID -> its queue
+    Memory::HashSet<std::uint64_t, POOL> waiting;  // (title, patron) pairs currently queued
+
+    static std::uint64_t key(int titleId, int patronId);
+
+public:
+    void push(int titleId, int patronId);
+    std::optional<int> pop(int titleId);
+    void clear();
+
+    [[nodiscard]] bool contains(int titleId, int patronId) const { return waiting.contains(key(titleId, patronId)); }
+    [[nodiscard]] std::size_t length(int titleId) const;
+
+    // Oldest first, f(patronId)
+    template<typename F>
+    void forEach(const int titleId, F f) const {
+        if (titleId < 0 || static_cast<std::size_t>(titleId) >= queues.size()) return;
+        for (std::uint32_t n = queues[titleId].head; n != NIL; n = nodes[n].next) f(nodes[n].patronId);
+    }
+
+    // Every title with a queue, f(titleId)
+    template<typename F>
+    void forEachTitle(F f) const {
+        for (std::size_t titleId = 0; titleId < queues.size(); ++titleId) {
+            if (queues[titleId].length) f(static_cast<int>(titleId));
+        }
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "PatronNameIndex.hpp"
+#include <algorithm>
+#include "CatalogSnapshot.hpp"
+
+void PatronNameIndex::add(const std::string& name, const int patronId) {
+    Name folded(foldCase(name));
+    exactNames.try_emplace(folded).first->second.push_back(patronId);
+    sortedNames.emplace(std::move(folded), patronId);
+}
+
+void PatronNameIndex::clear() {
+    exactNames.clear();
+    sortedNames.clear();
+}
+
+std::vector<int> PatronNameIndex::find(const std::string& prefix, const std::size_t limit) const {
+    std::vector<int> results;
+    if (limit == 0) return results;
+
+    const std::string folded = foldCase(prefix);
+
+    const auto exact = exactNames.find(std::string_view(folded));
+    if (exact != exactNames.end()) {
+        for (const int id : exact->second) {
+            if (results.size() == limit) return results;
+            results.push_back(id);
+        }
+    }
+
+    // Everything starting with the prefix sits right after lower_bound(prefix)
+    for (auto it = sortedNames.lower_bound({Name(folded), 0}); it != sortedNames.end() && results.size() < limit; ++it) {
+        if (it->first.compare(0, folded.size(), folded) != 0) break;
+        if (it->first.size() == folded.size()) continue;  // Exact match, already added
+        results.push_back(it->second);
+    }
+
+    return results;
+}
\ No newline at end of file
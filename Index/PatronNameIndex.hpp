@@ -0,0 +1,26 @@
+#ifndef FINAL_PROJECT_PATRONNAMEINDEX_HPP
+#define FINAL_PROJECT_PATRONNAMEINDEX_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Stats/Memory.hpp"
+
+// Case-folded patron names: a hash for exact lookups and an ordered set for prefix lookups
+class PatronNameIndex {
+private:
+    static constexpr auto POOL = Memory::Pool::Indexes;
+    using Name = Memory::String<POOL>;
+
+    Memory::HashMap<Name, Memory::Vector<int, POOL>, POOL, Memory::StringHash, std::equal_to<>> exactNames;
+    Memory::OrderedSet<std::pair<Name, int>, POOL> sortedNames;
+
+public:
+    void add(const std::string& name, int patronId);
+    void clear();
+
+    // Exact (case-insensitive) matches come first, then the rest of the prefix matches
+    [[nodiscard]] std::vector<int> find(const std::string& prefix, std::size_t limit) const;
+};
+
+#endif
\ No newline at end of file
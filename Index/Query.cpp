@@ -0,0 +1,200 @@
+#include "Query.hpp"
+#include <algorithm>
+#include <numeric>
+
+Query Query::titleContains(const std::string& text) {
+    Query q(Kind::TitleContains);
+    q.text = foldCase(text);
+    return q;
+}
+
+Query Query::authorContains(const std::string& text) {
+    Query q(Kind::AuthorContains);
+    q.text = foldCase(text);
+    return q;
+}
+
+Query Query::genreIs(const Book::Genre genre) {
+    Query q(Kind::GenreIs);
+    q.genre = genre;
+    return q;
+}
+
+Query Query::statusIs(const Book::BookStatus status) {
+    Query q(Kind::StatusIs);
+    q.status = status;
+    return q;
+}
+
+Query Query::typeIs(const BookKind type) {
+    Query q(Kind::TypeIs);
+    q.type = type;
+    return q;
+}
+
+Query Query::overdue() {
+    return Query(Kind::Overdue);
+}
+
+Query Query::dueBefore(const Date& date) {
+    Query q(Kind::DueBefore);
+    q.dayNumber = date.toDayNumber();
+    return q;
+}
+
+Query Query::allOf(std::vector<Query> parts) {
+    Query q(Kind::All);
+    q.children = std::move(parts);
+    return q;
+}
+
+Query Query::anyOf(std::vector<Query> parts) {
+    Query q(Kind::Any);
+    q.children = std::move(parts);
+    return q;
+}
+
+// Flatten chains like a && b && c into one node so the planner sees every option at once
+Query operator&&(Query a, Query b) {
+    if (a.kind == Query::Kind::All) {
+        a.children.push_back(std::move(b));
+        return a;
+    }
+    return Query::allOf({std::move(a), std::move(b)});
+}
+
+Query operator||(Query a, Query b) {
+    if (a.kind == Query::Kind::Any) {
+        a.children.push_back(std::move(b));
+        return a;
+    }
+    return Query::anyOf({std::move(a), std::move(b)});
+}
+
+namespace {
+    class Planner {
+    private:
+        const QueryContext& ctx;
+        const int today = Date().toDayNumber();
+
+        [[nodiscard]] std::size_t catalogSize() const { return ctx.books.size(); }
+
+        // Index that covers the predicate, nullptr if it needs a scan. Overdue and
+        // due-date checks only ever match checked-out books, so that set drives them.
+        [[nodiscard]] const BookIndexes::Rows* indexFor(const Query& q) const {
+            switch (q.kind) {
+                case Query::Kind::GenreIs: return &ctx.indexes.rowsWithGenre(q.genre);
+                case Query::Kind::TypeIs: return &ctx.indexes.rowsOfKind(q.type);
+                case Query::Kind::StatusIs:
+                    return q.status == Book::BookStatus::CheckedOut ? &ctx.indexes.checkedOut() : nullptr;
+                case Query::Kind::Overdue:
+                case Query::Kind::DueBefore: return &ctx.indexes.checkedOut();
+                default: return nullptr;
+            }
+        }
+
+        [[nodiscard]] bool indexIsExact(const Query& q) const {
+            return q.kind == Query::Kind::GenreIs || q.kind == Query::Kind::TypeIs || q.kind == Query::Kind::StatusIs;
+        }
+
+        // Rough number of rows we'd have to touch to produce this node's candidates
+        [[nodiscard]] std::size_t estimate(const Query& q) const {
+            if (q.kind == Query::Kind::All) {
+                std::size_t best = catalogSize();
+                for (const auto& child : q.children) best = std::min(best, estimate(child));
+                return best;
+            }
+            if (q.kind == Query::Kind::Any) {
+                std::size_t total = 0;
+                for (const auto& child : q.children) total += estimate(child);
+                return std::min(total, catalogSize());
+            }
+            const auto* index = indexFor(q);
+            return index ? index->size() : catalogSize();
+        }
+
+        std::vector<std::size_t> scan(const Query& q) const {
+            std::vector<std::size_t> rows;
+            for (std::size_t row = 0; row < catalogSize(); ++row) {
+                if (matches(q, row)) rows.push_back(row);
+            }
+            return rows;
+        }
+
+    public:
+        explicit Planner(const QueryContext& context) : ctx(context) {}
+
+        [[nodiscard]] bool matches(const Query& q, const std::size_t row) const {
+            const Book& book = *ctx.books[row];
+            const BookRecord& record = ctx.catalog.books[row];
+
+            switch (q.kind) {
+                case Query::Kind::TitleContains: return record.foldedTitle.find(q.text) != std::string::npos;
+                case Query::Kind::AuthorContains: return record.foldedAuthor.find(q.text) != std::string::npos;
+                case Query::Kind::GenreIs: return book.getGenre() == q.genre;
+                case Query::Kind::StatusIs: return book.getStatus() == q.status;
+                case Query::Kind::TypeIs: return BookIndexes::kindOf(book) == q.type;
+                case Query::Kind::Overdue:
+                    return book.getStatus() == Book::BookStatus::CheckedOut && book.getDueDate().has_value()
+                        && book.getDueDate()->toDayNumber() < today;
+                case Query::Kind::DueBefore:
+                    return book.getStatus() == Book::BookStatus::CheckedOut && book.getDueDate().has_value()
+                        && book.getDueDate()->toDayNumber() < q.dayNumber;
+                case Query::Kind::All:
+                    return std::ranges::all_of(q.children, [&](const Query& c) { return matches(c, row); });
+                case Query::Kind::Any:
+                    return std::ranges::any_of(q.children, [&](const Query& c) { return matches(c, row); });
+            }
+            return false;
+        }
+
+        [[nodiscard]] std::vector<std::size_t> evaluate(const Query& q) const {
+            if (q.kind == Query::Kind::All) {
+                if (q.children.empty()) {
+                    std::vector<std::size_t> rows(catalogSize());
+                    std::iota(rows.begin(), rows.end(), 0);
+                    return rows;
+                }
+
+                // Drive from the cheapest child, then check the others row by row
+                const auto driver = std::ranges::min_element(q.children, {}, [this](const Query& c) { return estimate(c); });
+                std::vector<std::size_t> rows = evaluate(*driver);
+                std::erase_if(rows, [&](const std::size_t row) {
+                    for (auto it = q.children.begin(); it != q.children.end(); ++it) {
+                        if (it != driver && !matches(*it, row)) return true;
+                    }
+                    return false;
+                });
+                return rows;
+            }
+
+            if (q.kind == Query::Kind::Any) {
+                // One unindexed branch means scanning anyway, so do it once for the whole OR
+                if (estimate(q) >= catalogSize()) return scan(q);
+
+                std::vector<std::size_t> rows;
+                for (const auto& child : q.children) {
+                    auto part = evaluate(child);
+                    rows.insert(rows.end(), part.begin(), part.end());
+                }
+                std::ranges::sort(rows);
+                rows.erase(std::ranges::unique(rows).begin(), rows.end());
+                return rows;
+            }
+
+            const auto* index = indexFor(q);
+            if (!index) return scan(q);
+            if (indexIsExact(q)) return {index->begin(), index->end()};
+
+            std::vector<std::size_t> rows;
+            std::ranges::copy_if(*index, std::back_inserter(rows), [&](const std::size_t row) { return matches(q, row); });
+            return rows;
+        }
+    };
+}
+
+std::vector<std::size_t> runQuery(const Query& query, const QueryContext& context) {
+    std::vector<std::size_t> rows = Planner(context).evaluate(query);
+    std::ranges::sort(rows);  // The checked-out index isn't kept in row order
+    return rows;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef FINAL_PROJECT_QUERY_HPP
+#define FINAL_PROJECT_QUERY_HPP
+
+#include <string>
+#include <vector>
+#include "Book/Book.hpp"
+#include "Index/BookIndexes.hpp"
+#include "CatalogSnapshot.hpp"
+
+// A predicate tree over books, e.g.
+//   Query::genreIs(Book::Genre::Mystery) && (Query::overdue() || Query::authorContains("christie"))
+class Query {
+public:
+    enum class Kind { TitleContains, AuthorContains, GenreIs, StatusIs, TypeIs, Overdue, DueBefore, All, Any };
+
+    Kind kind;
+    std::string text;  // Case-folded
+    Book::Genre genre = Book::Genre::Fiction;
+    Book::BookStatus status = Book::BookStatus::Available;
+    BookKind type = BookKind::Other;
+    int dayNumber = 0;
+    std::vector<Query> children;
+
+    static Query titleContains(const std::string& text);
+    static Query authorContains(const std::string& text);
+    static Query genreIs(Book::Genre genre);
+    static Query statusIs(Book::BookStatus status);
+    static Query typeIs(BookKind type);
+    static Query overdue();
+    static Query dueBefore(const Date& date);
+    static Query allOf(std::vector<Query> parts);
+    static Query anyOf(std::vector<Query> parts);
+
+    friend Query operator&&(Query a, Query b);
+    friend Query operator||(Query a, Query b);
+
+private:
+    explicit Query(Kind kind) : kind(kind) {}
+};
+
+// Everything the planner can read; rows are catalog rows and line up across all three
+struct QueryContext {
+    const std::vector<Book*>& books;
+    const CatalogSnapshot& catalog;
+    const BookIndexes& indexes;
+};
+
+// Picks the most selective index to produce candidates, then checks the rest of the
+// predicates on those rows only. Returns matching rows in catalog order.
+std::vector<std::size_t> runQuery(const Query& query, const QueryContext& context);
+
+#endif
\ No newline at end of file
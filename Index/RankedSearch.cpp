@@ -0,0 +1,95 @@
+#include "RankedSearch.hpp"
+#include "FuzzyIndex.hpp"
+#include "Stats/Metrics.hpp"
+#include <algorithm>
+#include <queue>
+
+namespace {
+    constexpr int TIER_WEIGHT = 1024;
+
+    struct Hit {
+        int score;
+        int bookId;
+    };
+
+    bool ranksBefore(const Hit& a, const Hit& b) {
+        return a.score != b.score ? a.score > b.score : a.bookId < b.bookId;
+    }
+}
+
+int relevance(const std::string& foldedField, const std::string& foldedTerm) {
+    if (foldedTerm.empty()) return 0;
+
+    const std::size_t first = foldedField.find(foldedTerm);
+    if (first == std::string::npos) return 0;
+
+    int tier = 1;
+    if (first == 0) tier = foldedField.size() == foldedTerm.size() ? 3 : 2;
+
+    int occurrences = 0;
+    for (std::size_t pos = first; pos != std::string::npos && occurrences < TIER_WEIGHT - 1;
+         pos = foldedField.find(foldedTerm, pos + foldedTerm.size())) {
+        occurrences++;
+    }
+
+    return tier * TIER_WEIGHT + occurrences;
+}
+
+SearchPage rankedSearch(const CatalogSnapshot& catalog, const SearchField field, const std::string& term,
+                        const std::size_t k, const std::optional<SearchCursor>& after,
+                        const std::function<bool()>& cancelled) {
+    Metrics::ScopedTimer timer(Metrics::Op::RankedSearch);
+    SearchPage page;
+    if (k == 0) return page;
+
+    const std::string folded = foldCase(term);
+
+    // Max-heap on "worst", so the top is what gets evicted when something better shows up
+    std::priority_queue<Hit, std::vector<Hit>, decltype(&ranksBefore)> heap(&ranksBefore);
+    std::size_t remaining = 0;  // Matches after the cursor
+    std::size_t scanned = 0;
+
+    for (const auto& record : catalog.books) {
+        if (cancelled && (++scanned & 4095) == 0 && cancelled()) return {};
+
+        const int score = relevance(field == SearchField::Title ? record.foldedTitle : record.foldedAuthor, folded);
+        if (score == 0) continue;
+        page.totalMatches++;
+
+        const Hit hit{score, record.id};
+        if (after && !ranksBefore({after->score, after->bookId}, hit)) continue;
+        remaining++;
+
+        if (heap.size() < k) heap.push(hit);
+        else if (ranksBefore(hit, heap.top())) {
+            heap.pop();
+            heap.push(hit);
+        }
+    }
+
+    std::vector<Hit> hits;
+    hits.reserve(heap.size());
+    while (!heap.empty()) {
+        hits.push_back(heap.top());
+        heap.pop();
+    }
+    std::ranges::reverse(hits);
+
+    page.bookIds.reserve(hits.size());
+    for (const auto& hit : hits) page.bookIds.push_back(hit.bookId);
+    if (remaining > hits.size()) page.next = SearchCursor{hits.back().score, hits.back().bookId};
+
+    return page;
+}
+
+std::vector<int> fuzzySearch(const CatalogSnapshot& catalog, const SearchField field, const std::string& term,
+                             const std::size_t limit, const std::function<bool()>& cancelled) {
+    std::vector<int> ids;
+    const auto& index = field == SearchField::Title ? catalog.fuzzyTitles : catalog.fuzzyAuthors;
+    if (!index) return ids;
+
+    const auto matches = index->search(term, limit, cancelled);
+    ids.reserve(matches.size());
+    for (const auto& match : matches) ids.push_back(match.bookId);
+    return ids;
+}
\ No newline at end of file
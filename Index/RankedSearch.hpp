@@ -0,0 +1,38 @@
+#ifndef FINAL_PROJECT_RANKEDSEARCH_HPP
+#define FINAL_PROJECT_RANKEDSEARCH_HPP
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+#include "CatalogSnapshot.hpp"
+
+enum class SearchField { Title, Author };
+
+// Position after the last result of a page. Results are ordered by score (best first), then book ID.
+struct SearchCursor {
+    int score;
+    int bookId;
+};
+
+struct SearchPage {
+    std::vector<int> bookIds;
+    std::size_t totalMatches = 0;       // Across all pages
+    std::optional<SearchCursor> next;   // Empty on the last page
+};
+
+// Exact match beats prefix beats substring; within a tier more occurrences rank higher. 0 = no match.
+int relevance(const std::string& foldedField, const std::string& foldedTerm);
+
+// One pass over the snapshot keeping the k best results in a bounded heap,
+// so nothing past the page is materialised or sorted
+SearchPage rankedSearch(const CatalogSnapshot& catalog, SearchField field, const std::string& term,
+                        std::size_t k, const std::optional<SearchCursor>& after = std::nullopt,
+                        const std::function<bool()>& cancelled = {});
+
+// Typo-tolerant fallback for when rankedSearch finds nothing, closest first. Goes through
+// the snapshot's trigram indexes, which never change under it, so it can run on a worker thread.
+std::vector<int> fuzzySearch(const CatalogSnapshot& catalog, SearchField field, const std::string& term,
+                             std::size_t limit, const std::function<bool()>& cancelled = {});
+
+#endif
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "TitleInventory.hpp"
+
+void TitleInventory::clear() {
+    titleIds.clear();
+    titles.clear();
+    titleOfRow.clear();
+    freeSlot.clear();
+}
+
+bool TitleInventory::add(const std::size_t row, const Book& book) {
+    const auto [it, isNew] = titleIds.emplace(book.getTitle(), static_cast<std::uint32_t>(titles.size()));
+    if (isNew) titles.emplace_back();
+
+    titles[it->second].copies.push_back(row);
+
+    if (row >= titleOfRow.size()) {
+        titleOfRow.resize(row + 1, 0);
+        freeSlot.resize(row + 1, NOT_FREE);
+    }
+    titleOfRow[row] = it->second;
+    setCheckedOut(row, book.getStatus() == Book::BookStatus::CheckedOut);
+
+    return isNew;
+}
+
+void TitleInventory::setCheckedOut(const std::size_t row, const bool checkedOut) {
+    auto& freeCopies = titles[titleOfRow[row]].freeCopies;
+    std::uint32_t& slot = freeSlot[row];
+
+    if (!checkedOut && slot == NOT_FREE) {
+        slot = static_cast<std::uint32_t>(freeCopies.size());
+        freeCopies.push_back(row);
+    } else if (checkedOut && slot != NOT_FREE) {
+        // Swap with the last entry so removal doesn't shift anything
+        const std::size_t last = freeCopies.back();
+        freeCopies[slot] = last;
+        freeSlot[last] = slot;
+        freeCopies.pop_back();
+        slot = NOT_FREE;
+    }
+}
+
+const TitleRecord* TitleInventory::find(const std::string& title) const {
+    const auto it = titleIds.find(std::string_view(title));
+    return it != titleIds.end() ? &titles[it->second] : nullptr;
+}
+
+std::size_t TitleInventory::firstCopy(const std::string& title) const {
+    const TitleRecord* record = find(title);
+    return record ? record->copies.front() : NO_ROW;
+}
+
+std::size_t TitleInventory::availableCopy(const std::string& title) const {
+    const TitleRecord* record = find(title);
+    return record && !record->freeCopies.empty() ? record->freeCopies.back() : NO_ROW;
+}
+
+CopyCount TitleInventory::count(const std::size_t row) const {
+    const TitleRecord& record = titles[titleOfRow[row]];
+    return {record.freeCopies.size(), record.copies.size()};
+}
\ No newline at end of file
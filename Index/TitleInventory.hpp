@@ -0,0 +1,55 @@
+#ifndef FINAL_PROJECT_TITLEINVENTORY_HPP
+#define FINAL_PROJECT_TITLEINVENTORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Book/Book.hpp"
+#include "Stats/Memory.hpp"
+
+// All catalog rows holding a copy of one title, plus the ones on the shelf
+struct TitleRecord {
+    using Rows = Memory::Vector<std::size_t, Memory::Pool::Indexes>;
+
+    Rows copies;      // Load order, so copies.front() is the first copy
+    Rows freeCopies;  // Available right now, taken from the back
+};
+
+struct CopyCount {
+    std::size_t available;
+    std::size_t total;
+};
+
+/* Groups catalog rows by title so checkout can grab any copy on the shelf instead of
+ * only the first one. The free list uses swap-remove like BookIndexes' checked-out set,
+ * so taking or returning a copy and counting availability are all O(1). */
+class TitleInventory {
+public:
+    static constexpr std::size_t NO_ROW = static_cast<std::size_t>(-1);
+
+private:
+    static constexpr std::uint32_t NOT_FREE = static_cast<std::uint32_t>(-1);
+
+    static constexpr auto POOL = Memory::Pool::Indexes;
+
+    // Exact title -> index into titles, looked up by string_view so checkout doesn't build a key
+    Memory::HashMap<Memory::String<POOL>, std::uint32_t, POOL, Memory::StringHash, std::equal_to<>> titleIds;
+    Memory::Vector<TitleRecord, POOL> titles;
+    Memory::Vector<std::uint32_t, POOL> titleOfRow;  // Row -> index into titles
+    Memory::Vector<std::uint32_t, POOL> freeSlot;    // Row -> position in its title's freeCopies
+
+    [[nodiscard]] const TitleRecord* find(const std::string& title) const;
+
+public:
+    void clear();
+    // Returns true if this is the first copy of the title
+    bool add(std::size_t row, const Book& book);
+    void setCheckedOut(std::size_t row, bool checkedOut);
+
+    [[nodiscard]] std::size_t firstCopy(const std::string& title) const;      // NO_ROW if unknown
+    [[nodiscard]] std::size_t availableCopy(const std::string& title) const;  // NO_ROW if none on the shelf
+    [[nodiscard]] const TitleRecord::Rows& copiesOf(std::size_t row) const { return titles[titleOfRow[row]].copies; }
+    [[nodiscard]] CopyCount count(std::size_t row) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "TitleTrie.hpp"
+#include <algorithm>
+#include "CatalogSnapshot.hpp"
+
+std::size_t TitleTrie::childSlot(const std::uint32_t node, const char c) const {
+    const auto& children = nodes[node].children;
+    const auto it = std::ranges::lower_bound(children, c, {}, [this](const std::uint32_t child) { return firstChar(child); });
+    return static_cast<std::size_t>(it - children.begin());
+}
+
+std::uint32_t TitleTrie::addLeaf(const std::uint32_t parent, const std::size_t slot, const std::string_view rest, const std::int32_t title) {
+    Node leaf;
+    leaf.labelStart = static_cast<std::uint32_t>(arena.size());
+    leaf.labelLength = static_cast<std::uint32_t>(rest.size());
+    leaf.title = title;
+    arena.append(rest);
+
+    const auto index = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back(std::move(leaf));
+    nodes[parent].children.insert(nodes[parent].children.begin() + static_cast<std::ptrdiff_t>(slot), index);
+    return index;
+}
+
+void TitleTrie::insert(const std::string& title) {
+    const std::string key = foldCase(title);
+    std::uint32_t node = 0;
+    std::size_t pos = 0;
+
+    while (pos < key.size()) {
+        const std::size_t slot = childSlot(node, key[pos]);
+        auto& children = nodes[node].children;
+
+        if (slot == children.size() || firstChar(children[slot]) != key[pos]) {
+            titles.emplace_back(title);
+            addLeaf(node, slot, std::string_view(key).substr(pos), static_cast<std::int32_t>(titles.size() - 1));
+            return;
+        }
+
+        const std::uint32_t child = children[slot];
+        const std::string_view edge = label(nodes[child]);
+        const std::string_view rest = std::string_view(key).substr(pos);
+        const auto common = static_cast<std::uint32_t>(std::ranges::mismatch(edge, rest).in1 - edge.begin());
+
+        if (common == edge.size()) {
+            node = child;
+            pos += common;
+            continue;
+        }
+
+        // Split the edge: the new middle node keeps the shared part of the label
+        Node middle;
+        middle.labelStart = nodes[child].labelStart;
+        middle.labelLength = common;
+        middle.children.push_back(child);
+        nodes[child].labelStart += common;
+        nodes[child].labelLength -= common;
+
+        const auto middleIndex = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back(std::move(middle));
+        nodes[node].children[slot] = middleIndex;
+
+        titles.emplace_back(title);
+        const auto titleIndex = static_cast<std::int32_t>(titles.size() - 1);
+        if (common == rest.size()) nodes[middleIndex].title = titleIndex;
+        else addLeaf(middleIndex, childSlot(middleIndex, rest[common]), rest.substr(common), titleIndex);
+        return;
+    }
+
+    // Key ends on an existing node, only new if no title ended here yet (extra copies share it)
+    if (nodes[node].title < 0 && node != 0) {
+        titles.emplace_back(title);
+        nodes[node].title = static_cast<std::int32_t>(titles.size() - 1);
+    }
+}
+
+void TitleTrie::clear() {
+    arena.clear();
+    nodes.assign(1, Node{});
+    titles.clear();
+}
+
+std::vector<std::string> TitleTrie::complete(const std::string& prefix, const std::size_t limit) const {
+    std::vector<std::string> results;
+    if (limit == 0) return results;
+
+    const std::string key = foldCase(prefix);
+    std::uint32_t node = 0;
+    std::size_t pos = 0;
+
+    while (pos < key.size()) {
+        const std::size_t slot = childSlot(node, key[pos]);
+        const auto& children = nodes[node].children;
+        if (slot == children.size() || firstChar(children[slot]) != key[pos]) return results;
+
+        node = children[slot];
+        const std::string_view edge = label(nodes[node]);
+        const std::size_t n = std::min(edge.size(), key.size() - pos);
+        if (edge.substr(0, n) != std::string_view(key).substr(pos, n)) return results;
+        pos += n;
+    }
+
+    // Pre-order walk with children in order gives alphabetical results, stop as soon as we have enough
+    std::vector<std::uint32_t> stack{node};
+    while (!stack.empty() && results.size() < limit) {
+        const Node& current = nodes[stack.back()];
+        stack.pop_back();
+
+        if (current.title >= 0) results.emplace_back(titles[current.title]);
+        for (auto it = current.children.rbegin(); it != current.children.rend(); ++it) stack.push_back(*it);
+    }
+
+    return results;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef FINAL_PROJECT_TITLETRIE_HPP
+#define FINAL_PROJECT_TITLETRIE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Stats/Memory.hpp"
+
+/* Radix trie over case-folded titles for autocomplete.
+ * Edge labels are slices of one shared character arena, so splitting a node
+ * never copies strings, and titles are inserted one at a time as books are added. */
+class TitleTrie {
+private:
+    static constexpr auto POOL = Memory::Pool::Indexes;
+
+    struct Node {
+        std::uint32_t labelStart = 0;
+        std::uint32_t labelLength = 0;
+        std::int32_t title = -1;                       // Index into titles if a key ends here
+        Memory::Vector<std::uint32_t, POOL> children;  // Sorted by first label character
+    };
+
+    Memory::String<POOL> arena;
+    Memory::Vector<Node, POOL> nodes{Node{}};
+    Memory::Vector<Memory::String<POOL>, POOL> titles;  // Display spelling of each distinct title
+
+    [[nodiscard]] std::string_view label(const Node& n) const { return {arena.data() + n.labelStart, n.labelLength}; }
+    [[nodiscard]] char firstChar(std::uint32_t node) const { return arena[nodes[node].labelStart]; }
+    [[nodiscard]] std::size_t childSlot(std::uint32_t node, char c) const;
+    std::uint32_t addLeaf(std::uint32_t parent, std::size_t slot, std::string_view rest, std::int32_t title);
+
+public:
+    void insert(const std::string& title);
+    void clear();
+
+    // Up to limit titles starting with prefix (case-insensitive), in alphabetical order
+    [[nodiscard]] std::vector<std::string> complete(const std::string& prefix, std::size_t limit) const;
+    [[nodiscard]] std::size_t size() const { return titles.size(); }
+};
+
+#endif
\ No newline at end of file
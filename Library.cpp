@@ -1,138 +1,156 @@
 #include "Library.hpp"
+#include "RecordFormats.hpp"
 #include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <iostream>
 #include <filesystem>
 #include <ranges>
 #include <cctype>
+#include <unordered_set>
+#include <utility>
+
+// Parsers and formatters for the data files, the field handling lives in RecordFormats.hpp
 
 Book* parseBookLine(const std::string& line) {
-    std::stringstream ss(line);
-    std::string genreStr, title, author, type, extraData, statusStr, checkoutDateStr, dueDateStr, patronIdStr;
-
-    std::getline(ss, genreStr, '|');
-    std::getline(ss, title, '|');
-    std::getline(ss, author, '|');
-    std::getline(ss, type, '|');
-    std::getline(ss, extraData, '|');
-    std::getline(ss, statusStr, '|');
-    std::getline(ss, checkoutDateStr, '|');
-    std::getline(ss, dueDateStr, '|');
-    std::getline(ss, patronIdStr, '|');
-
-    const Book::Genre genre = Book::stringToGenre(genreStr);
+    BookLine fields;
+    BookSchema::parseText(line, fields);
+
     Book* book = nullptr;
 
-    if (type == "EBook") {
-        const double fileSize = std::stod(extraData);
-        book = new EBook(title, author, genre, fileSize);
-    } else if (type == "PrintedBook") {
-        const int pages = std::stoi(extraData);
-        book = new PrintedBook(title, author, genre, pages);
+    if (fields.type == "EBook") {
+        double fileSize;
+        if (!Schema::Text<double>::parse(fields.extra, fileSize)) throw std::invalid_argument("Invalid file size: '" + std::string(fields.extra) + "'");
+        book = new EBook(std::string(fields.title), std::string(fields.author), fields.genre, fileSize);
+    } else if (fields.type == "PrintedBook") {
+        int pages;
+        if (!Schema::Text<int>::parse(fields.extra, pages)) throw std::invalid_argument("Invalid page count: '" + std::string(fields.extra) + "'");
+        book = new PrintedBook(std::string(fields.title), std::string(fields.author), fields.genre, pages);
     } else {
-        book = new Book(title, author, genre);
+        book = new Book(std::string(fields.title), std::string(fields.author), fields.genre);
     }
 
-    // Restore checkout state if available
-    if (!statusStr.empty()) {
-        if (statusStr == "CheckedOut") {
-            book->setStatus(Book::BookStatus::CheckedOut);
+    // Older files have no ID column, those books just get the next free ID
+    if (fields.id) book->setId(*fields.id);
 
-            if (!checkoutDateStr.empty() && checkoutDateStr != "null") {
-                int d, m, y;
-                char delim;
-                std::stringstream cdss(checkoutDateStr);
-                cdss >> d >> delim >> m >> delim >> y;
-                book->setCheckoutDate(Date(d, m, y));
-            }
-
-            if (!dueDateStr.empty() && dueDateStr != "null") {
-                int d, m, y;
-                char delim;
-                std::stringstream ddss(dueDateStr);
-                ddss >> d >> delim >> m >> delim >> y;
-                book->setDueDate(Date(d, m, y));
-            }
-
-            if (!patronIdStr.empty() && patronIdStr != "null") book->setCurrentPatronId(std::stoi(patronIdStr));
-
-        } else {
-            book->setStatus(Book::BookStatus::Available);
-        }
+    // Restore checkout state, the dates and patron only mean something while it's out
+    if (fields.status.value == Book::BookStatus::CheckedOut) {
+        book->setStatus(Book::BookStatus::CheckedOut);
+        if (const auto& date = fields.checkoutDate.value) book->setCheckoutDate(*date);
+        if (const auto& date = fields.dueDate.value) book->setDueDate(*date);
+        if (const auto& patronId = fields.patronId.value) book->setCurrentPatronId(*patronId);
+    } else {
+        book->setStatus(Book::BookStatus::Available);
     }
 
     return book;
 }
 
-std::string bookToString(const Book* book) {
-    std::string result = Book::genreToString(book->getGenre()) + "|" + book->getTitle() + "|" + book->getAuthor() + "|";
+void formatBookLine(const BookRecord& record, const BookState& state, std::string& out) {
+    // typeColumns already holds "type|extra"
+    const std::string_view typeColumns = record.typeColumns;
+    const auto bar = typeColumns.find('|');
 
-    if (auto* ebook = dynamic_cast<const EBook*>(book)) result += "EBook|" + std::to_string(ebook->getFileSize()) + "|";
-    else if (auto* printed = dynamic_cast<const PrintedBook*>(book)) result += "PrintedBook|" + std::to_string(printed->getPageCount()) + "|";
-    else result += "Unknown|0|";
+    BookLine fields;
+    fields.genre = record.genre;
+    fields.title = record.title;
+    fields.author = record.author;
+    fields.type = typeColumns.substr(0, bar);
+    fields.extra = bar == std::string_view::npos ? std::string_view{} : typeColumns.substr(bar + 1);
+    fields.status.value = state.status;
+    fields.checkoutDate.value = state.checkoutDate;
+    fields.dueDate.value = state.dueDate;
+    fields.patronId.value = state.patronId;
+    fields.id = record.id;
 
-    result += (book->getStatus() == Book::BookStatus::Available ? "Available|" : "CheckedOut|");
+    BookSchema::formatText(fields, out);
+}
 
-    // Checkout date
-    if (book->getCheckoutDate().has_value()) result += book->getCheckoutDate()->toString() + "|";
-    else result += "null|";
+Patron parsePatronLine(const std::string& line) {
+    PatronLine fields;
+    PatronSchema::parseText(line, fields);
+    return {std::string(fields.name), fields.id};
+}
 
-    // Due date
-    if (book->getDueDate().has_value()) result += book->getDueDate()->toString() + "|";
-    else result += "null|";
+void formatPatronLine(const PatronRecord& patron, std::string& out) {
+    PatronSchema::formatText({patron.id, patron.name}, out);
+}
 
-    // Current patron ID
-    if (book->getCurrentPatronId().has_value()) result += std::to_string(book->getCurrentPatronId().value());
-    else result += "null";
+HoldRecord parseHoldLine(const std::string& line) {
+    HoldLine fields;
+    HoldSchema::parseText(line, fields);
+    return {fields.patronId, std::string(fields.title)};
+}
 
-    return result;
+void formatHoldLine(const HoldRecord& hold, std::string& out) {
+    HoldSchema::formatText({hold.patronId, hold.title}, out);
 }
 
-Patron parsePatronLine(const std::string& line) {
-    std::stringstream ss(line);
-    std::string idStr, name;
+Transaction parseTransactionLine(const std::string& line, Library& library) {
+    TransactionLine fields;
+    TransactionTextSchema::parseText(line, fields);
 
-    std::getline(ss, idStr, '|');
-    std::getline(ss, name, '|');
+    const Book* book = library.findBook(std::string(fields.title));
+    if (!book) throw std::runtime_error("Unknown book title: " + std::string(fields.title));
 
-    int id = std::stoi(idStr);
-    return {name, id};
+    return {fields.patronId, book->getId(), Transaction::stringToType(fields.type), fields.date};
 }
 
-std::string patronToString(const Patron& patron) {
-    return std::to_string(patron.getId()) + "|" + patron.getName();
-}
-
-Transaction parseTransactionLine(const std::string& line) {
-    std::stringstream ss(line);
-    std::string patronIdStr, bookTitle, transactionTypeStr, dateStr;
+void formatTransactionLine(const Transaction& transaction, const std::unordered_map<int, const std::string*>& titles, std::string& out) {
+    // A book that's left the catalog is written as #id so the line still says something
+    char missing[16] = "#";
+    std::string_view title;
+    if (const auto it = titles.find(transaction.getBookID()); it != titles.end()) {
+        title = *it->second;
+    } else {
+        const auto end = std::to_chars(missing + 1, missing + sizeof(missing), transaction.getBookID()).ptr;
+        title = {missing, static_cast<std::size_t>(end - missing)};
+    }
 
-    std::getline(ss, patronIdStr, '|');
-    std::getline(ss, bookTitle, '|');
-    std::getline(ss, transactionTypeStr, '|');
-    std::getline(ss, dateStr, '|');
+    TransactionTextSchema::formatText({transaction.getPatronID(), title, transaction.typeToString(), transaction.getDate()}, out);
+}
 
-    int patronId = std::stoi(patronIdStr);
+// The writers below only see a snapshot, so they're safe to run on a background thread
+namespace {
+    void writeBooks(const CatalogSnapshot& snapshot, const std::string& filename) {
+        saveToFile(std::views::iota(std::size_t{0}, snapshot.books.size()), filename,
+            [&snapshot](const std::size_t row, std::string& out) { formatBookLine(snapshot.books[row], snapshot.bookStates[row], out); });
+    }
 
-    int day, month, year;
-    char delimiter;
-    std::stringstream dateStream(dateStr);
-    dateStream >> day >> delimiter >> month >> delimiter >> year;
+    // Only the newest layout has IDs, a line without one is a book someone typed in
+    std::optional<int> idOfBookLine(const std::string_view line) {
+        if (static_cast<std::size_t>(std::ranges::count(line, '|')) != BookSchema::FIELD_COUNT - 1) return std::nullopt;
+        int id;
+        if (!Schema::Text<int>::parse(line.substr(line.rfind('|') + 1), id)) return std::nullopt;
+        return id;
+    }
 
-    Date transactionDate(day, month, year);
+    bool sameState(const BookState& a, const BookState& b) {
+        return a.status == b.status && a.checkoutDate == b.checkoutDate && a.dueDate == b.dueDate && a.patronId == b.patronId;
+    }
 
-    TransactionType type = Transaction::stringToType(transactionTypeStr);
+    // Copies the index first if a snapshot can still see it, like ChunkedVector does with its chunks
+    FuzzyIndex& writable(std::shared_ptr<FuzzyIndex>& index) {
+        if (index.use_count() > 1) {
+            index = std::make_shared<FuzzyIndex>(*index);
+        } else {
+            // Pairs with the release in the reader's shared_ptr destructor, their searches finish before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *index;
+    }
 
-    return {patronId, bookTitle, type, transactionDate};
-}
+    void writeTransactionsText(const CatalogSnapshot& snapshot, const std::string& filename) {
+        std::unordered_map<int, const std::string*> titles;
+        for (const auto& record : snapshot.books) titles.emplace(record.id, &record.title);
 
-std::string transactionToString(const Transaction& transaction) {
-    return std::to_string(transaction.getPatronID()) + "|" +
-           transaction.getBookTitle() + "|" +
-           transaction.typeToString() + "|" +
-           transaction.getDate().toString();
+        saveToFile(snapshot.transactions, filename,
+            [&titles](const Transaction& t, std::string& out) { formatTransactionLine(t, titles, out); });
+    }
 }
 
 Library::~Library() {
+    if (lastSave.valid()) lastSave.wait();
     for (const auto book : books) delete book;
 }
 
@@ -144,54 +162,560 @@ void Library::loadBooks(const std::string& filename) {
     // Load new books
     loadFromFile(books, filename, parseBookLine);
 
+    // A line without an ID gets the next free one, which a later line may then claim as its own
+    std::unordered_set<int> ids;
+    std::erase_if(books, [&ids](const Book* book) {
+        if (ids.insert(book->getId()).second) return false;
+        std::cerr << "Skipping book with duplicate ID " << book->getId() << ": " << book->getTitle() << std::endl;
+        delete book;
+        return true;
+    });
+    rebuildBookIndexes();
+    rememberSavedBooks(catalog);
+
     // Rebuild patron-book associations
     rebuildPatronBorrowedBooks();
+
+    for (auto* listener : listeners) listener->booksReset();
 }
 
 void Library::loadPatrons(const std::string& filename) {
-    loadFromFile(patrons, filename, parsePatronLine);
+    setPatrons(readPatrons(filename));
+}
+
+std::vector<Patron> Library::readPatrons(const std::string& filename) {
+    std::vector<Patron> loaded;
+    loadFromFile(loaded, filename, parsePatronLine);
+    return loaded;
+}
+
+void Library::setPatrons(std::vector<Patron> loaded) {
+    patrons = std::move(loaded);
+
+    patronRowsById.clear();
+    patronNames.clear();
+    catalog.patrons.clear();
+    for (std::size_t i = 0; i < patrons.size(); ++i) {
+        patronRowsById.emplace(patrons[i].getId(), i);
+        patronNames.add(patrons[i].getName(), patrons[i].getId());
+        catalog.patrons.push_back({patrons[i].getId(), patrons[i].getName()});
+    }
 }
 
 void Library::loadTransactions(const std::string& filename) {
-    loadFromFile(transactions, filename, parseTransactionLine);
+    catalog.transactionsLoaded = false;  // Until the read and replay both succeed
+    TransactionList loaded;
+
+    // First run after switching formats: pick up the old text log instead
+    if (!TransactionLog::read(loaded, filename)) {
+        importTransactions();
+        return;
+    }
+    setTransactions(std::move(loaded));
+}
+
+void Library::importTransactions(const std::string& filename) {
+    catalog.transactionsLoaded = false;
+    TransactionList loaded;
+    loadFromFile(loaded, filename,
+        [this](const std::string& line) { return parseTransactionLine(line, *this); });
+    setTransactions(std::move(loaded));
+}
+
+// Only marked loaded once the whole log is in and replayed, a half-read log must never get saved over the real one
+void Library::setTransactions(TransactionList loaded) {
+    catalog.transactions = std::move(loaded);
+    try {
+        replayTransactionLog();
+    } catch (...) {
+        catalog.transactions.clear();
+        catalog.transactionsLoaded = false;
+        circulation.clear();
+        coBorrowing.clear();
+        notifyTransactionsReset();
+        throw;
+    }
+    catalog.transactionsLoaded = true;
+    notifyTransactionsReset();
 }
 
 void Library::saveBooks(const std::string& filename) const {
-    saveToFile(books, filename, bookToString);
+    writeBooks(catalog, filename);
 }
 
 void Library::savePatrons(const std::string& filename) const {
-    saveToFile(patrons, filename, patronToString);
+    saveToFile(catalog.patrons, filename, formatPatronLine);
 }
 
 void Library::saveTransactions(const std::string& filename) const {
-    saveToFile(transactions, filename, transactionToString);
+    if (!catalog.transactionsLoaded) throw std::runtime_error("Transactions haven't been loaded yet.");
+    TransactionLog::write(catalog.transactions, filename);
+}
+
+void Library::exportTransactions(const std::string& filename) const {
+    if (!catalog.transactionsLoaded) throw std::runtime_error("Transactions haven't been loaded yet.");
+    writeTransactionsText(catalog, filename);
+}
+
+void Library::loadHolds(const std::string& filename) {
+    holds.clear();
+    holdList.reset();
+
+    if (!std::filesystem::exists(filename)) {
+        std::cout << "No holds file found, starting with empty queues." << std::endl;
+        return;
+    }
+
+    // Queued as each line is parsed so bad lines are reported the same way as everywhere else
+    std::vector<HoldRecord> loaded;
+    loadFromFile(loaded, filename, [this](const std::string& line) {
+        HoldRecord hold = parseHoldLine(line);
+        const Book* book = findBook(hold.title);
+        if (!book) throw std::runtime_error("Unknown book title: " + hold.title);
+        if (!findPatron(hold.patronId)) throw std::runtime_error("Unknown patron ID: " + std::to_string(hold.patronId));
+        if (!holds.contains(book->getId(), hold.patronId)) holds.push(book->getId(), hold.patronId);
+        return hold;
+    });
+}
+
+BookReload Library::reloadBooks(const std::string& filename) {
+    BookReload result;
+    if (loading || readOnly) return result;
+    // Our own saves end up here too, don't read one half written
+    if (lastSave.valid()) lastSave.wait();
+
+    Trace::Span span("reloadBooks", "io", filename);
+    std::ifstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Failed to open file: " + filename);
+
+    // Edits that move a book in the indexes wait until the whole file's been read
+    struct Edit {
+        std::size_t row;
+        std::unique_ptr<Book> book;
+        bool replace;  // A different type or type column, so it can't be the same object
+    };
+    std::vector<Edit> edits;
+    std::vector<std::unique_ptr<Book>> added;
+    std::vector<bool> seen(books.size(), false);
+
+    std::string line;
+    std::string current;
+    int lineNum = 0;
+
+    while (std::getline(file, line)) {
+        lineNum++;
+        if (line.empty()) continue;
+
+        try {
+            const auto id = idOfBookLine(line);
+            const Book* existing = id ? findBookById(*id) : nullptr;
+            if (!existing) {
+                added.emplace_back(parseBookLine(line));
+                continue;
+            }
+
+            const std::size_t row = rowOf(existing);
+            if (seen[row]) throw std::runtime_error("Duplicate book ID: " + std::to_string(*id));
+            seen[row] = true;
+
+            // Nearly every line is untouched, and writing one out is much cheaper than parsing it
+            current.clear();
+            formatBookLine(catalog.books[row], catalog.bookStates[row], current);
+            if (current == line) continue;
+
+            std::unique_ptr<Book> edited(parseBookLine(line));
+            const BookRecord& before = catalog.books[row];
+            const BookRecord after(*edited);
+
+            if (after.typeColumns != before.typeColumns) {
+                edits.push_back({row, std::move(edited), true});
+                result.changed++;
+                continue;
+            }
+
+            const bool stateChanged = !sameState(BookState(*edited), catalog.bookStates[row]);
+            if (stateChanged) applyBookState(row, *edited);
+            const bool detailsChanged = after.title != before.title || after.author != before.author || after.genre != before.genre;
+            if (detailsChanged) edits.push_back({row, std::move(edited), false});
+            if (stateChanged || detailsChanged) result.changed++;
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing line " << lineNum << ": " << e.what() << std::endl;
+        }
+    }
+
+    // Books added here since the last save were never in the file, so they aren't deleted
+    for (std::size_t row = 0; row < books.size(); ++row) {
+        if (!seen[row] && !wasSaved(books[row]->getId())) seen[row] = true;
+    }
+    result.removed = static_cast<std::size_t>(std::ranges::count(seen, false));
+    const bool reindex = !edits.empty() || result.removed > 0;
+
+    if (reindex) {
+        // Holds are keyed by the first copy of a title, which may be about to change or go,
+        // so remember each one by the copy and title it's on now
+        struct Waiting {
+            int bookId;
+            int patronId;
+            std::string title;
+        };
+        std::vector<Waiting> waiting;
+        holds.forEachTitle([&](const int titleId) {
+            const Book* book = findBookById(titleId);
+            if (!book) return;
+            holds.forEach(titleId, [&](const int patronId) { waiting.push_back({titleId, patronId, book->getTitle()}); });
+        });
+
+        for (auto& [row, edited, replace] : edits) {
+            Book*& book = books[row];
+            if (replace) {
+                unlinkBorrower(book);
+                delete book;
+                book = edited.release();
+                linkBorrower(book);
+            } else {
+                book->copyDetailsFrom(*edited);
+            }
+        }
+
+        if (result.removed > 0) {
+            std::size_t kept = 0;
+            for (std::size_t row = 0; row < books.size(); ++row) {
+                if (seen[row]) {
+                    books[kept++] = books[row];
+                    continue;
+                }
+                unlinkBorrower(books[row]);
+                delete books[row];
+            }
+            books.resize(kept);
+        }
+
+        rebuildBookIndexes();
+
+        holds.clear();
+        holdList.reset();
+        for (const auto& [bookId, patronId, title] : waiting) {
+            const Book* book = findBookById(bookId);
+            if (!book) book = findBook(title);
+            if (!book || !findPatron(patronId)) continue;
+            const int titleId = titleIdOf(book->getId());
+            if (!holds.contains(titleId, patronId)) holds.push(titleId, patronId);
+        }
+
+        // Genres and title IDs may have moved under the statistics
+        if (catalog.transactionsLoaded) replayTransactionLog();
+    }
+
+    const std::size_t first = books.size();
+    for (auto& book : added) {
+        if (findBookById(book->getId())) {
+            std::cerr << "Skipping new book with duplicate ID " << book->getId() << std::endl;
+            continue;
+        }
+        Book* b = book.release();
+        appendBook(b);
+        linkBorrower(b);
+        markSaved(b->getId());
+    }
+    result.added = books.size() - first;
+
+    if (reindex) {
+        for (auto* listener : listeners) listener->booksReset();
+    } else if (result.added > 0) {
+        for (auto* listener : listeners) listener->booksAppended(first, result.added);
+    }
+
+    std::cout << "Reloaded " << filename << ": " << result.added << " added, " << result.changed
+              << " changed, " << result.removed << " removed" << std::endl;
+
+    // Outside edits aren't in the change log, so replicas start over from a new base
+    if (isShipping() && !result.empty()) rebaseReplicas();
+    return result;
 }
 
 void Library::loadData() {
+    Metrics::ScopedTimer timer(Metrics::Op::LoadData);
+    Trace::Span span("loadData", "library");
     try {
         loadPatrons();
         loadBooks();
-        loadTransactions();
+        loadHolds();
+        deferTransactions("Data/Transactions.bin");
 
         std::cout << "\nAll data loaded successfully!" << std::endl;
+
+        const Memory::Usage memory = memoryUsage().total();
+        std::cout << "Catalog holds " << memory.bytes << " bytes of heap in " << memory.blocks << " blocks" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Error loading data: " << e.what() << std::endl;
     }
 }
 
 void Library::saveData() const {
+    if (loading) throw std::runtime_error("Can't save while the catalog is still loading.");
+    requireWritable();
+    // Don't race a background save for the same files
+    if (lastSave.valid()) lastSave.wait();
+    const auto saving = snapshot();
+    rememberSavedBooks(*saving);
+    saveSnapshot(*saving);
+}
+
+void Library::saveDataInBackground() const {
+    if (loading || readOnly) return;
+    auto saving = snapshot();
+    rememberSavedBooks(*saving);
+    lastSave = std::async(std::launch::async, [previous = lastSave, snapshot = std::move(saving)]() mutable {
+        if (previous.valid()) previous.wait();
+        previous = {};  // Otherwise every save keeps the one before it alive
+        saveSnapshot(*snapshot);
+    }).share();
+}
+
+bool Library::saveSnapshot(const CatalogSnapshot& snapshot, const std::string& directory) {
+    Metrics::ScopedTimer timer(Metrics::Op::SaveData);
+    Trace::Span span("saveData", "library", directory);
     try {
-        saveBooks();
-        savePatrons();
-        saveTransactions();
+        writeBooks(snapshot, directory + "/Books.txt");
+        saveToFile(snapshot.patrons, directory + "/Patrons.txt", formatPatronLine);
+        // Never loaded means never changed, the file on disk is still right
+        if (snapshot.transactionsLoaded) TransactionLog::write(snapshot.transactions, directory + "/Transactions.bin");
+        if (snapshot.holds) saveToFile(*snapshot.holds, directory + "/Holds.txt", formatHoldLine);
         std::cout << "\nAll data saved successfully!" << std::endl;
+        return true;
     } catch (const std::exception& e) {
         std::cerr << "Error saving data: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void Library::dumpStats(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Failed to open file for writing: " + filename);
+    file << Metrics::toJson(stats());
+    std::cout << "Saved operation statistics to " << filename << std::endl;
+}
+
+Memory::Snapshot Library::memoryUsage() const {
+    using Memory::Pool;
+    using Memory::heapOf;
+
+    // Everything with a counting allocator is already in here, add what lives in std containers
+    Memory::Snapshot usage = Memory::collect();
+    usage[Pool::PatronObjects] += heapOf(patrons);
+    usage[Pool::Indexes] += heapOf(books);
+
+    Memory::Usage& strings = usage[Pool::Strings];
+    for (const Book* book : books) {
+        strings += heapOf(book->getTitle());
+        strings += heapOf(book->getAuthor());
+    }
+    for (const Patron& patron : patrons) strings += heapOf(patron.getName());
+
+    for (const BookRecord& record : catalog.books) {
+        for (const std::string* s : {&record.title, &record.author, &record.foldedTitle, &record.foldedAuthor, &record.typeColumns}) {
+            strings += heapOf(*s);
+        }
+    }
+    for (const PatronRecord& record : catalog.patrons) strings += heapOf(record.name);
+    if (holdList) {
+        for (const HoldRecord& hold : *holdList) strings += heapOf(hold.title);
+    }
+
+    return usage;
+}
+
+void Library::dumpMemoryUsage(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Failed to open file for writing: " + filename);
+    file << Memory::toJson(memoryUsage());
+    std::cout << "Saved memory usage to " << filename << std::endl;
+}
+
+void Library::readBooks(const std::string& filename, const std::size_t batchSize,
+                        const std::function<bool(std::vector<Book*>)>& onBatch) {
+    Trace::Span span("readBooks", "io", filename);
+    std::ifstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Failed to open file: " + filename);
+
+    std::vector<Book*> batch;
+    batch.reserve(batchSize);
+    std::string line;
+    int lineNum = 0;
+    int successCount = 0;
+
+    while (std::getline(file, line)) {
+        lineNum++;
+        if (line.empty()) continue;
+
+        try {
+            batch.push_back(parseBookLine(line));
+            successCount++;
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing line " << lineNum << ": " << e.what() << std::endl;
+        }
+
+        if (batch.size() == batchSize) {
+            if (!onBatch(std::exchange(batch, {}))) return;
+            batch.reserve(batchSize);
+        }
+    }
+
+    if (!batch.empty()) onBatch(std::move(batch));
+    std::cout << "Loaded " << successCount << " items from " << filename << std::endl;
+}
+
+void Library::beginLoading() {
+    if (lastSave.valid()) lastSave.wait();
+    loading = true;
+
+    for (auto& patron : patrons) patron.clearBorrowedBooks();
+    for (const auto* book : books) delete book;
+    books.clear();
+    rebuildBookIndexes();
+    holds.clear();
+    holdList.reset();
+
+    for (auto* listener : listeners) listener->booksReset();
+}
+
+void Library::appendBooks(const std::vector<Book*>& batch) {
+    const std::size_t first = books.size();
+    for (Book* b : batch) {
+        if (!b) continue;
+        try {
+            appendBook(b);
+        } catch (const std::exception& e) {
+            std::cerr << "Skipping book: " << e.what() << std::endl;
+            delete b;
+        }
+    }
+    for (auto* listener : listeners) listener->booksAppended(first, books.size() - first);
+}
+
+void Library::finishLoading(const std::string& directory) {
+    rebuildPatronBorrowedBooks();
+    try {
+        loadHolds(directory + "/Holds.txt");
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading holds: " << e.what() << std::endl;
+    }
+    deferTransactions(directory + "/Transactions.bin");
+    rememberSavedBooks(catalog);
+    loading = false;
+}
+
+void Library::deferTransactions(const std::string& filename) {
+    transactionsFile = filename;
+    catalog.transactions.clear();
+    catalog.transactionsLoaded = false;
+    circulation.clear();
+    coBorrowing.clear();
+    notifyTransactionsReset();
+}
+
+void Library::ensureTransactionsLoaded() {
+    if (!catalog.transactionsLoaded) loadTransactions(transactionsFile);
+}
+
+void Library::shipChangesTo(const std::string& directory) {
+    if (loading) throw std::runtime_error("Can't start shipping while the catalog is still loading.");
+    requireWritable();
+    ensureTransactionsLoaded();  // Replicas get the whole history in Base/
+
+    // Replicas wait while there's no log, so they never take a half-written Base/ for a whole one
+    shipping.reset();
+    std::filesystem::create_directories(directory + "/Base");
+    std::filesystem::remove(Replication::logPath(directory));
+    if (lastSave.valid()) lastSave.wait();
+    if (!saveSnapshot(*snapshot(), directory + "/Base")) throw std::runtime_error("Couldn't write the replica base to " + directory + "/Base");
+
+    shipping = std::make_unique<Replication::ChangeLogWriter>(directory);
+    shippingDirectory = directory;
+    rebaseNeeded = false;
+}
+
+// Called once the change is already in the catalog, so failing to log it can't undo it. The
+// replicas just start over from a new base, which has the change in it.
+void Library::ship(const Replication::Change& change) {
+    if (shipping) {
+        try {
+            shipping->append(change);
+            return;
+        } catch (const std::exception& e) {
+            std::cerr << "Couldn't log change for replicas, they'll get a new base: " << e.what() << std::endl;
+            shipping.reset();
+            // Replicas wait while there's no log instead of reading one with a hole in it
+            std::error_code ignored;
+            std::filesystem::remove(Replication::logPath(shippingDirectory), ignored);
+            rebaseNeeded = true;
+        }
+    }
+    if (rebaseNeeded) rebaseReplicas();
+}
+
+void Library::rebaseReplicas() {
+    try {
+        shipChangesTo(shippingDirectory);
+    } catch (const std::exception& e) {
+        std::cerr << "Couldn't write a new base for replicas, trying again on the next change: " << e.what() << std::endl;
+        shipping.reset();
+        rebaseNeeded = true;
+    }
+}
+
+void Library::requireWritable() const {
+    if (readOnly) throw std::runtime_error("This terminal is a read-only replica.");
+}
+
+// The replica side of ship(), same steps as the original operation minus the checks and
+// the hold hand-off (which the primary logs as changes of its own)
+void Library::applyChange(const Replication::Change& change) {
+    using Replication::ChangeType;
+
+    switch (change.type) {
+        case ChangeType::Checkout:
+        case ChangeType::Return: {
+            ensureTransactionsLoaded();
+            Patron* patron = findPatron(change.patronId);
+            Book* book = findBookById(change.bookId);
+            if (!patron || !book) throw std::runtime_error("Change refers to an unknown book or patron.");
+
+            const Date on = Date::fromDayNumber(change.day);
+            if (change.type == ChangeType::Checkout) lendCopy(*patron, rowOf(book), on);
+            else takeBack(*patron, book, on);
+            break;
+        }
+        case ChangeType::AddBook: {
+            std::unique_ptr<Book> added(parseBookLine(std::string(change.text)));
+            if (findBookById(added->getId())) throw std::runtime_error("Change adds a book ID that's already taken: " + std::to_string(added->getId()));
+            appendBook(added.get());  // Throws on an out of range ID
+            Book* b = added.release();
+            linkBorrower(b);
+            for (auto* listener : listeners) listener->bookAppended(books.size() - 1);
+            break;
+        }
+        case ChangeType::AddPatron:
+            insertPatron(Patron(std::string(change.text), change.patronId));
+            break;
+        // Hold queues are a table indexed by title ID, so check it's a real one first
+        case ChangeType::PlaceHold:
+            if (!findBookById(change.bookId) || !findPatron(change.patronId)) throw std::runtime_error("Change refers to an unknown book or patron.");
+            if (!holds.contains(change.bookId, change.patronId)) holds.push(change.bookId, change.patronId);
+            holdList.reset();
+            break;
+        case ChangeType::ServeHold:
+            if (!findBookById(change.bookId)) throw std::runtime_error("Change refers to an unknown book.");
+            holds.pop(change.bookId);
+            holdList.reset();
+            break;
+        default:
+            throw std::runtime_error("Unknown change type in the change log.");
     }
 }
 
 void Library::rebuildPatronBorrowedBooks() {
+    Trace::Span span("rebuildPatronBorrowedBooks", "library");
     for (auto& patron : patrons) patron.clearBorrowedBooks();
 
     for (auto* book : books) {
@@ -203,57 +727,387 @@ void Library::rebuildPatronBorrowedBooks() {
     }
 }
 
+void Library::linkBorrower(Book* book) {
+    if (book->getStatus() != Book::BookStatus::CheckedOut) return;
+    if (const auto patronId = book->getCurrentPatronId()) {
+        if (Patron* patron = findPatron(*patronId)) patron->addBorrowedBook(book);
+    }
+}
+
+void Library::unlinkBorrower(const Book* book) {
+    if (const auto patronId = book->getCurrentPatronId()) {
+        if (Patron* patron = findPatron(*patronId)) patron->removeBorrowedBook(book);
+    }
+}
+
+// Checkout state edited outside the program, no transaction is logged for it
+void Library::applyBookState(const std::size_t row, const Book& edited) {
+    Book* book = books[row];
+    const bool wasOut = book->getStatus() == Book::BookStatus::CheckedOut;
+
+    unlinkBorrower(book);
+    book->copyStateFrom(edited);
+    linkBorrower(book);
+
+    const bool isOut = book->getStatus() == Book::BookStatus::CheckedOut;
+    catalog.bookStates.set(row, BookState(*book));
+    if (wasOut != isOut) {
+        bookIndexes.setCheckedOut(row, isOut);
+        inventory.setCheckedOut(row, isOut);
+    }
+    notifyCopiesChanged(row);
+}
+
 void Library::addBook(Book* b) {
     if (!b) throw std::invalid_argument("Cannot add null book.");
-    books.push_back(b);
+    requireWritable();
+    appendBook(b);
+
+    for (auto* listener : listeners) listener->bookAppended(books.size() - 1);
+    if (isShipping()) {
+        std::string line;
+        formatBookLine(catalog.books.back(), catalog.bookStates.back(), line);
+        ship({.type = Replication::ChangeType::AddBook, .text = line});
+    }
     std::cout << "Book '" << b->getTitle() << "' by " << b->getAuthor() << " added to library." << std::endl;
 }
 
 void Library::addPatron(const Patron& p) {
+    requireWritable();
+    insertPatron(p);
+    ship({.type = Replication::ChangeType::AddPatron, .patronId = p.getId(), .text = p.getName()});
+}
+
+void Library::insertPatron(const Patron& p) {
     if (findPatron(p.getId()) != nullptr) throw std::runtime_error("Patron with ID " + std::to_string(p.getId()) + " already exists.");
     patrons.push_back(p);
+    patronRowsById.emplace(p.getId(), patrons.size() - 1);
+    patronNames.add(p.getName(), p.getId());
+    catalog.patrons.push_back({p.getId(), p.getName()});
     std::cout << "Patron '" << p.getName() << "' added to library." << std::endl;
 }
 
 void Library::checkoutBook(int patronId, const std::string& title) {
+    Metrics::ScopedTimer timer(Metrics::Op::Checkout);
+    requireWritable();
+    ensureTransactionsLoaded();
     Patron* patron = findPatron(patronId);
     if (!patron) throw std::runtime_error("Patron with ID " + std::to_string(patronId) + " not found.");
 
-    Book* book = findBook(title);
-    if (!book) throw std::runtime_error("Book '" + title + "' not found.");
+    // Any copy on the shelf will do, not just the first one
+    const std::size_t row = inventory.availableCopy(title);
+    if (row == NO_ROW) {
+        if (inventory.firstCopy(title) == NO_ROW) throw std::runtime_error("Book '" + title + "' not found.");
+        throw std::runtime_error("No copies of '" + title + "' are available.");
+    }
 
-    patron->borrowBook(book);
-    transactions.emplace_back(patronId, title, TransactionType::Checkout);
+    lendCopy(*patron, row);
+}
 
-    saveData();
+void Library::lendCopy(Patron& patron, const std::size_t row, const Date& on) {
+    Book* book = books[row];
+
+    patron.borrowBook(book, on);
+    catalog.transactions.emplace_back(patron.getId(), book->getId(), TransactionType::Checkout, on);
+
+    catalog.bookStates.set(row, BookState(*book));
+    const int titleId = titleIdOf(book->getId());
+    circulation.recordCheckout(catalog.transactions.back(), titleId, book->getGenre());
+    coBorrowing.recordCheckout(patron.getId(), titleId);
+    bookIndexes.setCheckedOut(row, true);
+    inventory.setCheckedOut(row, true);
+    notifyCopiesChanged(row);
+    notifyTransactionAppended();
+
+    // Last, a re-base after a failed write snapshots the catalog and has to see all of the above
+    ship({.type = Replication::ChangeType::Checkout, .patronId = patron.getId(), .bookId = book->getId(), .day = on.toDayNumber()});
 }
 
-void Library::returnBook(int patronId, const std::string& title) {
+std::optional<int> Library::returnBook(int patronId, const std::string& title) {
+    Metrics::ScopedTimer timer(Metrics::Op::Return);
+    requireWritable();
+    ensureTransactionsLoaded();
     Patron* patron = findPatron(patronId);
     if (!patron) throw std::runtime_error("Patron with ID " + std::to_string(patronId) + " not found.");
 
-    Book* book = findBook(title);
+    // The copy this patron has, falling back to the first copy so a wrong title still gets a clear error
+    const auto& borrowed = patron->getBorrowedBooks();
+    const auto it = std::ranges::find(borrowed, title, &Book::getTitle);
+    Book* book = it != borrowed.end() ? *it : findBook(title);
     if (!book) throw std::runtime_error("Book '" + title + "' not found.");
 
-    patron->returnBook(book);  // This calls book->returnBook() and removes from patron's vector
-    transactions.emplace_back(patronId, title, TransactionType::Return);
+    const std::size_t row = takeBack(*patron, book);
+
+    // Hand the copy straight to the next patron waiting for this title
+    const int titleId = titleIdOf(book->getId());
+    while (const auto next = holds.pop(titleId)) {
+        holdList.reset();
+        ship({.type = Replication::ChangeType::ServeHold, .bookId = titleId});
+
+        // Skip anyone who has since left or got hold of another copy
+        Patron* waiting = findPatron(*next);
+        if (!waiting || std::ranges::find(waiting->getBorrowedBooks(), book->getTitle(), &Book::getTitle) != waiting->getBorrowedBooks().end()) continue;
+
+        lendCopy(*waiting, row);
+        return next;
+    }
+    return std::nullopt;
+}
+
+std::size_t Library::takeBack(Patron& patron, Book* book, const Date& on) {
+    patron.returnBook(book);  // This calls book->returnBook() and removes from patron's vector
+    catalog.transactions.emplace_back(patron.getId(), book->getId(), TransactionType::Return, on);
+
+    const std::size_t row = rowOf(book);
+    catalog.bookStates.set(row, BookState(*book));
+    circulation.recordReturn(catalog.transactions.back());
+    bookIndexes.setCheckedOut(row, false);
+    inventory.setCheckedOut(row, false);
+    notifyCopiesChanged(row);
+    notifyTransactionAppended();
+
+    ship({.type = Replication::ChangeType::Return, .patronId = patron.getId(), .bookId = book->getId(), .day = on.toDayNumber()});
+    return row;
+}
+
+std::size_t Library::placeHold(const int patronId, const std::string& title) {
+    requireWritable();
+    const Patron* patron = findPatron(patronId);
+    if (!patron) throw std::runtime_error("Patron with ID " + std::to_string(patronId) + " not found.");
+
+    const std::size_t first = inventory.firstCopy(title);
+    if (first == NO_ROW) throw std::runtime_error("Book '" + title + "' not found.");
+    if (inventory.availableCopy(title) != NO_ROW) throw std::runtime_error("A copy of '" + title + "' is available, check it out instead.");
+
+    const auto& borrowed = patron->getBorrowedBooks();
+    if (std::ranges::find(borrowed, title, &Book::getTitle) != borrowed.end()) throw std::runtime_error("Patron already has this book borrowed.");
+
+    const int titleId = books[first]->getId();
+    if (holds.contains(titleId, patronId)) throw std::runtime_error("Patron is already waiting for this book.");
+
+    holds.push(titleId, patronId);
+    holdList.reset();
+    ship({.type = Replication::ChangeType::PlaceHold, .patronId = patronId, .bookId = titleId});
+    return holds.length(titleId);
+}
+
+std::size_t Library::holdsOn(const Book* book) const {
+    return book ? holds.length(titleIdOf(book->getId())) : 0;
+}
+
+std::shared_ptr<const HoldList> Library::holdRecords() const {
+    if (!holdList) {
+        auto list = std::allocate_shared<HoldList>(Memory::Allocator<HoldList, Memory::Pool::Snapshot>());
+        holds.forEachTitle([this, &list](const int titleId) {
+            const Book* book = findBookById(titleId);
+            if (!book) return;
+            holds.forEach(titleId, [&](const int patronId) { list->push_back({patronId, book->getTitle()}); });
+        });
+        holdList = std::move(list);
+    }
+    return holdList;
+}
 
-    saveData();
+std::shared_ptr<const CatalogSnapshot> Library::snapshot() const {
+    auto copy = std::make_shared<CatalogSnapshot>(catalog);
+    copy->holds = holdRecords();
+    copy->fuzzyTitles = fuzzyTitles;
+    copy->fuzzyAuthors = fuzzyAuthors;
+    return copy;
 }
 
 Book* Library::findBook(const std::string& title) {
-    const auto it = std::ranges::find_if(books,
-        [&title](const Book* b) { return b->getTitle() == title; });
-    return (it != books.end()) ? *it : nullptr;
+    Metrics::ScopedTimer timer(Metrics::Op::FindBook, 64);
+    const std::size_t row = inventory.firstCopy(title);
+    return row != NO_ROW ? books[row] : nullptr;
+}
+
+CopyCount Library::copiesOf(const Book* book) const {
+    const std::size_t row = rowOf(book);
+    return row != NO_ROW ? inventory.count(row) : CopyCount{0, 0};
 }
 
 Patron* Library::findPatron(int id) {
-    const auto it = std::ranges::find_if(patrons,
-        [id](const Patron& p) { return p.getId() == id; });
-    return (it != patrons.end()) ? &(*it) : nullptr;
+    Metrics::ScopedTimer timer(Metrics::Op::FindPatron, 64);
+    const auto it = patronRowsById.find(id);
+    return (it != patronRowsById.end()) ? &patrons[it->second] : nullptr;
+}
+
+std::vector<Patron*> Library::findPatronsByName(const std::string& prefix, const std::size_t limit) {
+    std::vector<Patron*> results;
+    for (const int id : patronNames.find(prefix, limit)) {
+        if (Patron* patron = findPatron(id)) results.push_back(patron);
+    }
+    return results;
+}
+
+std::vector<std::string> Library::completeTitles(const std::string& prefix, const std::size_t limit) const {
+    return titleDictionary.complete(prefix, limit);
+}
+
+Book* Library::findBookById(const int id) const {
+    if (id < 0 || static_cast<std::size_t>(id) >= bookRowsById.size()) return nullptr;
+    const std::size_t row = bookRowsById[id];
+    return row != NO_ROW ? books[row] : nullptr;
+}
+
+void Library::appendBook(Book* b) {
+    if (b->getId() < 1 || b->getId() > Book::MAX_ID) throw std::out_of_range("Book ID out of range: " + std::to_string(b->getId()));
+    if (findBookById(b->getId())) throw std::invalid_argument("Duplicate book ID: " + std::to_string(b->getId()));
+    books.push_back(b);
+    indexBook(books.size() - 1);
+
+    catalog.books.emplace_back(*b);
+    catalog.bookStates.emplace_back(*b);
+}
+
+void Library::indexBook(const std::size_t row) {
+    const Book* b = books[row];
+    const auto id = static_cast<std::size_t>(b->getId());
+    if (id >= bookRowsById.size()) bookRowsById.resize(id + 1, NO_ROW);
+    bookRowsById[id] = row;
+    bookIndexes.add(row, *b);
+    writable(fuzzyTitles).add(b->getTitle(), b->getId());
+    writable(fuzzyAuthors).add(b->getAuthor(), b->getId());
+    // Only new titles go in the dictionary
+    if (inventory.add(row, *b)) titleDictionary.insert(b->getTitle());
+}
+
+void Library::rebuildBookIndexes() {
+    Trace::Span span("rebuildBookIndexes", "library");
+    bookRowsById.clear();
+    inventory.clear();
+    titleDictionary.clear();
+    bookIndexes.clear();
+    fuzzyTitles = std::make_shared<FuzzyIndex>();  // Snapshots still out keep the old ones
+    fuzzyAuthors = std::make_shared<FuzzyIndex>();
+    for (std::size_t row = 0; row < books.size(); ++row) indexBook(row);
+
+    // Snapshots handed out earlier keep their own chunks
+    catalog.books.clear();
+    catalog.bookStates.clear();
+    catalog.books.reserve(books.size());
+    catalog.bookStates.reserve(books.size());
+    for (const auto* book : books) {
+        catalog.books.emplace_back(*book);
+        catalog.bookStates.emplace_back(*book);
+    }
+}
+
+void Library::replayTransactionLog() {
+    Trace::Span span("replayTransactionLog", "library");
+    // Books no longer in the catalog keep counting under their own ID
+    circulation.rebuild(catalog.transactions,
+        [this](const int bookId) {
+            const int titleId = titleIdOf(bookId);
+            return titleId >= 0 ? titleId : bookId;
+        },
+        [this](const int bookId) -> std::optional<Book::Genre> {
+            const Book* book = findBookById(bookId);
+            return book ? std::optional(book->getGenre()) : std::nullopt;
+        });
+
+    coBorrowing.clear();
+    for (const auto& t : catalog.transactions) {
+        if (t.getType() == TransactionType::Checkout) coBorrowing.recordCheckout(t.getPatronID(), titleIdOf(t.getBookID()));
+    }
+}
+
+// Copies share a title ID, the ID of the first copy (the one findBook hands out)
+int Library::titleIdOf(const int bookId) const {
+    const Book* book = findBookById(bookId);
+    if (!book) return -1;
+    const std::size_t first = inventory.firstCopy(book->getTitle());
+    return first != NO_ROW ? books[first]->getId() : bookId;
+}
+
+void Library::rememberSavedBooks(const CatalogSnapshot& saved) const {
+    savedBooks.assign(bookRowsById.size(), false);
+    for (const auto& record : saved.books) markSaved(record.id);
+}
+
+void Library::markSaved(const int bookId) const {
+    const auto id = static_cast<std::size_t>(bookId);
+    if (id >= savedBooks.size()) savedBooks.resize(id + 1, false);
+    savedBooks[id] = true;
+}
+
+bool Library::wasSaved(const int bookId) const {
+    const auto id = static_cast<std::size_t>(bookId);
+    return id < savedBooks.size() && savedBooks[id];
+}
+
+std::size_t Library::rowOf(const Book* b) const {
+    const auto id = static_cast<std::size_t>(b->getId());
+    return id < bookRowsById.size() ? bookRowsById[id] : NO_ROW;
+}
+
+void Library::addListener(LibraryListener* listener) {
+    if (listener && std::ranges::find(listeners, listener) == listeners.end()) listeners.push_back(listener);
+}
+
+void Library::removeListener(LibraryListener* listener) {
+    std::erase(listeners, listener);
+}
+
+void Library::notifyBookChanged(const std::size_t row) const {
+    if (row == NO_ROW) return;
+    for (auto* listener : listeners) listener->bookChanged(row);
+}
+
+// "n of m available" changes on every copy of the title, not just the one that moved
+void Library::notifyCopiesChanged(const std::size_t row) const {
+    for (const std::size_t copy : inventory.copiesOf(row)) notifyBookChanged(copy);
+}
+
+void Library::notifyTransactionAppended() const {
+    for (auto* listener : listeners) listener->transactionAppended(catalog.transactions.size() - 1);
+}
+
+void Library::notifyTransactionsReset() const {
+    for (auto* listener : listeners) listener->transactionsReset();
+}
+
+std::vector<Book*> Library::alsoBorrowed(const Book* book, const std::size_t k) const {
+    std::vector<Book*> results;
+    if (!book) return results;
+    for (const int titleId : coBorrowing.similar(titleIdOf(book->getId()), k)) {
+        if (Book* other = findBookById(titleId)) results.push_back(other);
+    }
+    return results;
+}
+
+std::vector<Book*> Library::recommendFor(const int patronId, const std::size_t k) const {
+    std::vector<Book*> results;
+    for (const int titleId : coBorrowing.forPatron(patronId, k)) {
+        if (Book* book = findBookById(titleId)) results.push_back(book);
+    }
+    return results;
+}
+
+std::vector<Book*> Library::query(const Query& q) const {
+    std::vector<Book*> results;
+    for (const std::size_t row : runQuery(q, {books, catalog, bookIndexes})) results.push_back(books[row]);
+    return results;
+}
+
+SearchPage Library::searchBooksRanked(const std::string& term, const SearchField field, const std::size_t k,
+                                      const std::optional<SearchCursor>& after) const {
+    return rankedSearch(catalog, field, term, k, after);
+}
+
+std::vector<Book*> Library::fuzzySearch(const std::string& term, const SearchField field, const std::size_t limit) const {
+    const FuzzyIndex& index = field == SearchField::Title ? *fuzzyTitles : *fuzzyAuthors;
+
+    std::vector<Book*> results;
+    for (const auto& match : index.search(term, limit)) {
+        if (Book* book = findBookById(match.bookId)) results.push_back(book);
+    }
+    return results;
 }
 
 std::vector<Book*> Library::searchBooksByAuthor(const std::string& author) const {
+    Metrics::ScopedTimer timer(Metrics::Op::SearchByAuthor);
     std::vector<Book*> results;
     std::string searchAuthor = author;
     std::ranges::transform(searchAuthor, searchAuthor.begin(), ::tolower);
@@ -269,6 +1123,7 @@ std::vector<Book*> Library::searchBooksByAuthor(const std::string& author) const
 }
 
 std::vector<Book*> Library::searchBooksByGenre(Book::Genre genre) const {
+    Metrics::ScopedTimer timer(Metrics::Op::SearchByGenre);
     std::vector<Book*> results;
     std::ranges::copy_if(books, std::back_inserter(results),
         [genre](const Book* b) { return b->getGenre() == genre; });
@@ -276,6 +1131,7 @@ std::vector<Book*> Library::searchBooksByGenre(Book::Genre genre) const {
 }
 
 std::vector<Book*> Library::searchBooksByTitle(const std::string& title) const {
+    Metrics::ScopedTimer timer(Metrics::Op::SearchByTitle);
     std::vector<Book*> results;
     std::string searchTitle = title;
     std::ranges::transform(searchTitle, searchTitle.begin(), ::tolower);
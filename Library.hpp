@@ -7,13 +7,33 @@
 #include <sstream>
 #include <stdexcept>
 #include <iostream>
+#include <functional>
+#include <future>
 #include <memory>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include "Book/Book.hpp"
 #include "Book/EBook.hpp"
 #include "Book/PrintedBook.hpp"
 #include "Transaction/Patron.hpp"
 #include "Transaction/Transaction.hpp"
+#include "Transaction/TransactionLog.hpp"
+#include "Replication/ChangeLog.hpp"
+#include "CatalogSnapshot.hpp"
+#include "Index/PatronNameIndex.hpp"
+#include "Index/TitleTrie.hpp"
+#include "Index/BookIndexes.hpp"
+#include "Index/Query.hpp"
+#include "Index/RankedSearch.hpp"
+#include "Index/FuzzyIndex.hpp"
+#include "Index/TitleInventory.hpp"
+#include "Index/HoldQueues.hpp"
+#include "Stats/CirculationStats.hpp"
+#include "Stats/CoBorrowIndex.hpp"
+#include "Stats/Metrics.hpp"
+#include "Stats/Trace.hpp"
+#include "Stats/Memory.hpp"
 
 /* Templates... templates...
  * Why does this assignment force you upon me?
@@ -25,25 +45,40 @@ template<typename T>
 void saveToFile(const std::vector<T*>& items, const std::string& filename,
                 std::string (*itemToString)(const T*)) {
 
+    Trace::Span span("saveToFile", "io", filename);
     std::ofstream file(filename);
     if (!file.is_open()) throw std::runtime_error("Failed to open file for writing: " + filename);
 
     for (const auto& item : items) file << itemToString(item) << std::endl;
 
     file.close();
+    if (!file) throw std::runtime_error("Failed to write file: " + filename);  // Disk full and the like
     std::cout << "Saved " << items.size() << " items to " << filename << std::endl;
 }
 
-template<typename T>
-void saveToFile(const std::vector<T>& items, const std::string& filename,
-                std::string (*itemToString)(const T&)) {
+// Formatters either return the line or append it to a buffer that's reused for every item
+template<typename Container, typename Formatter>
+void saveToFile(const Container& items, const std::string& filename,
+                Formatter itemToString) {
 
+    Trace::Span span("saveToFile", "io", filename);
     std::ofstream file(filename);
     if (!file.is_open()) throw std::runtime_error("Failed to open file for writing: " + filename);
 
-    for (const auto& item : items) file << itemToString(item) << std::endl;
+    std::string line;
+    for (const auto& item : items) {
+        if constexpr (std::is_invocable_v<Formatter&, decltype(item), std::string&>) {
+            line.clear();
+            itemToString(item, line);
+        } else {
+            line = itemToString(item);
+        }
+        line.push_back('\n');
+        file << line;
+    }
 
     file.close();
+    if (!file) throw std::runtime_error("Failed to write file: " + filename);  // Disk full and the like
     std::cout << "Saved " << items.size() << " items to " << filename << std::endl;
 }
 
@@ -51,12 +86,18 @@ template<typename T>
 void loadFromFile(std::vector<T*>& items, const std::string& filename,
                   T* (*parseLine)(const std::string&)) {
 
-    std::ifstream file(filename);
+    Trace::Span span("loadFromFile", "io", filename);
+    std::ifstream file;
+    {
+        Trace::Span openSpan("open", "io", filename);
+        file.open(filename);
+    }
     if (!file.is_open()) throw std::runtime_error("Failed to open file: " + filename);
 
     std::string line;
     int lineNum = 0;
     int successCount = 0;
+    Trace::Span parseSpan("parse", "io", filename);
 
     while (std::getline(file, line)) {
         lineNum++;
@@ -64,7 +105,7 @@ void loadFromFile(std::vector<T*>& items, const std::string& filename,
 
         try {
             T* item = parseLine(line);
-            items.push_back(item);
+            items.push_back(std::move(item));
             successCount++;
         } catch (const std::exception& e) {
             std::cerr << "Error parsing line " << lineNum << ": " << e.what() << std::endl;
@@ -75,11 +116,17 @@ void loadFromFile(std::vector<T*>& items, const std::string& filename,
     std::cout << "Loaded " << successCount << " items from " << filename << std::endl;
 }
 
-template<typename T>
-void loadFromFile(std::vector<T>& items, const std::string& filename,
-                  T (*parseLine)(const std::string&)) {
+template<typename Container, typename Parser>
+void loadFromFile(Container& items, const std::string& filename,
+                  Parser parseLine) {
+    using T = typename Container::value_type;
 
-    std::ifstream file(filename);
+    Trace::Span span("loadFromFile", "io", filename);
+    std::ifstream file;
+    {
+        Trace::Span openSpan("open", "io", filename);
+        file.open(filename);
+    }
     if (!file.is_open()) {
         if constexpr (std::is_same_v<T, Transaction>) {
             std::cout << "No transactions file found, starting with empty log." << std::endl;
@@ -91,6 +138,7 @@ void loadFromFile(std::vector<T>& items, const std::string& filename,
     std::string line;
     int lineNum = 0;
     int successCount = 0;
+    Trace::Span parseSpan("parse", "io", filename);
 
     while (std::getline(file, line)) {
         lineNum++;
@@ -98,7 +146,7 @@ void loadFromFile(std::vector<T>& items, const std::string& filename,
 
         try {
             T item = parseLine(line);
-            items.push_back(item);
+            items.push_back(std::move(item));
             successCount++;
         } catch (const std::exception& e) {
             std::cerr << "Error parsing line " << lineNum << ": " << e.what() << std::endl;
@@ -109,11 +157,100 @@ void loadFromFile(std::vector<T>& items, const std::string& filename,
     std::cout << "Loaded " << successCount << " items from " << filename << std::endl;
 }
 
+// What Library::reloadBooks() found had changed
+struct BookReload {
+    std::size_t added = 0;
+    std::size_t changed = 0;
+    std::size_t removed = 0;
+
+    [[nodiscard]] bool empty() const { return added + changed + removed == 0; }
+};
+
+// Implemented by views that want to patch single rows instead of rebuilding after every change
+class LibraryListener {
+public:
+    virtual ~LibraryListener() = default;
+
+    virtual void bookChanged(std::size_t /*row*/) {}
+    virtual void bookAppended(std::size_t /*row*/) {}
+    virtual void booksAppended(std::size_t first, std::size_t count) {
+        for (std::size_t row = first; row < first + count; ++row) bookAppended(row);
+    }
+    virtual void booksReset() {}
+    virtual void transactionAppended(std::size_t /*row*/) {}
+    virtual void transactionsReset() {}  // The whole log was swapped out (read in, or dropped until needed)
+};
+
 class Library {
 private:
+    static constexpr std::size_t NO_ROW = static_cast<std::size_t>(-1);
+
     std::vector<Book*> books;
     std::vector<Patron> patrons;
-    std::vector<Transaction> transactions;
+
+    // Lookup indexes so a desk operation doesn't scan the catalog
+    Memory::Vector<std::size_t, Memory::Pool::Indexes> bookRowsById;  // Book ID -> row in books, IDs are handed out densely
+    TitleInventory inventory;  // Copies of each title and which are on the shelf
+    HoldQueues holds;          // Patrons waiting on each title
+    Memory::HashMap<int, std::size_t, Memory::Pool::Indexes> patronRowsById;
+    PatronNameIndex patronNames;
+    TitleTrie titleDictionary;
+    BookIndexes bookIndexes;
+    std::shared_ptr<FuzzyIndex> fuzzyTitles = std::make_shared<FuzzyIndex>();  // Shared with snapshots, copied before a change while one holds it
+    std::shared_ptr<FuzzyIndex> fuzzyAuthors = std::make_shared<FuzzyIndex>();
+    CirculationStats circulation;
+    CoBorrowIndex coBorrowing;
+
+    std::vector<LibraryListener*> listeners;
+
+    // Live copy of what gets saved, also the only home of the transaction log.
+    // Kept in step with books/patrons, snapshot() hands out versions of it.
+    CatalogSnapshot catalog;
+
+    mutable std::shared_ptr<const HoldList> holdList;  // Reset whenever a queue changes
+
+    // Last background save, the next one waits for it so files are written in order
+    mutable std::shared_future<void> lastSave;
+
+    // By book ID, the books Books.txt had at the last load or save. A reload only deletes those,
+    // a book added since isn't missing from the file, it just hasn't been written yet
+    mutable std::vector<bool> savedBooks;
+
+    bool loading = false;  // Between beginLoading() and finishLoading(), nothing gets saved
+    bool readOnly = false;  // Replicas only change through applyChange()
+
+    // Set on a primary, every change is appended here for the replicas
+    std::unique_ptr<Replication::ChangeLogWriter> shipping;
+    std::string shippingDirectory;
+    // A change couldn't be logged, so the log was dropped and replicas need a new base. Retried on every change.
+    bool rebaseNeeded = false;
+    std::string transactionsFile = "Data/Transactions.bin";  // Read by ensureTransactionsLoaded()
+
+    void indexBook(std::size_t row);
+    void applyBookState(std::size_t row, const Book& edited);
+    void linkBorrower(Book* book);
+    void unlinkBorrower(const Book* book);
+    void appendBook(Book* b);  // Throws on an ID out of range or already taken
+    void deferTransactions(const std::string& filename);
+    void rebuildBookIndexes();
+    void lendCopy(Patron& patron, std::size_t row, const Date& on = Date());
+    std::size_t takeBack(Patron& patron, Book* book, const Date& on = Date());
+    void insertPatron(const Patron& p);
+    void ship(const Replication::Change& change);
+    void rebaseReplicas();
+    void requireWritable() const;
+    [[nodiscard]] std::shared_ptr<const HoldList> holdRecords() const;
+    void replayTransactionLog();
+    void setTransactions(TransactionList loaded);
+    [[nodiscard]] int titleIdOf(int bookId) const;
+    [[nodiscard]] std::size_t rowOf(const Book* b) const;
+    void notifyBookChanged(std::size_t row) const;
+    void notifyCopiesChanged(std::size_t row) const;
+    void notifyTransactionAppended() const;
+    void notifyTransactionsReset() const;
+    void rememberSavedBooks(const CatalogSnapshot& saved) const;
+    void markSaved(int bookId) const;
+    [[nodiscard]] bool wasSaved(int bookId) const;
 
 public:
     ~Library();
@@ -121,29 +258,115 @@ public:
     // File I/O methods
     void loadBooks(const std::string& filename = "Data/Books.txt");
     void loadPatrons(const std::string& filename = "Data/Patrons.txt");
-    void loadTransactions(const std::string& filename = "Data/Transactions.txt");
+    void loadTransactions(const std::string& filename = "Data/Transactions.bin");
+    void importTransactions(const std::string& filename = "Data/Transactions.txt");
     void saveBooks(const std::string& filename = "Data/Books.txt") const;
     void savePatrons(const std::string& filename = "Data/Patrons.txt") const;
-    void saveTransactions(const std::string& filename = "Data/Transactions.txt") const;
+    void saveTransactions(const std::string& filename = "Data/Transactions.bin") const;
+    void exportTransactions(const std::string& filename = "Data/Transactions.txt") const;
+    void loadHolds(const std::string& filename = "Data/Holds.txt");
+    // Picks up an outside edit of Books.txt without starting over. Lines that still match the
+    // book in memory aren't parsed, edited ones are applied to the existing Book, new IDs are
+    // appended and missing ones removed. Checkout edits and new lines only touch their own rows,
+    // removals and title/author/genre/type edits re-index the catalog (from memory, not the file).
+    BookReload reloadBooks(const std::string& filename = "Data/Books.txt");
+    // Patrons, books and holds. The transaction log is left on disk until ensureTransactionsLoaded().
     void loadData();
     void saveData() const;
+    // Saves a snapshot on another thread and returns straight away
+    void saveDataInBackground() const;
+    // False (after logging why) if any file couldn't be written
+    static bool saveSnapshot(const CatalogSnapshot& snapshot, const std::string& directory = "Data");
+
+    // Background loading. The read functions don't touch the Library and can run on any thread
+    // (as long as no one else creates Books or Patrons meanwhile, their ID counters aren't
+    // atomic), the rest apply what was read on the Library's own thread.
+    static std::vector<Patron> readPatrons(const std::string& filename = "Data/Patrons.txt");
+    // onBatch gets (and owns) batchSize books at a time, fewer at the end. Returning false stops reading.
+    static void readBooks(const std::string& filename, std::size_t batchSize,
+                          const std::function<bool(std::vector<Book*>)>& onBatch);
+    void beginLoading();
+    void setPatrons(std::vector<Patron> loaded);
+    void appendBooks(const std::vector<Book*>& batch);
+    void finishLoading(const std::string& directory = "Data");
+    [[nodiscard]] bool isLoading() const { return loading; }
+
+    // The log is only read the first time something needs it: the history view, a report,
+    // or a checkout/return (which do it themselves)
+    [[nodiscard]] bool transactionsLoaded() const { return catalog.transactionsLoaded; }
+    void ensureTransactionsLoaded();
+
+    // Primary/replica log shipping through a shared directory (see Replication/ChangeLog.hpp).
+    // shipChangesTo() writes the catalog to directory/Base and logs every change after it,
+    // a replica (Replication::Replica) loads Base and applies the log through applyChange().
+    void shipChangesTo(const std::string& directory);
+    [[nodiscard]] bool isShipping() const { return shipping != nullptr || rebaseNeeded; }
+    void applyChange(const Replication::Change& change);
+    // Checkouts, returns, holds, adds and saves throw (or do nothing, for background saves)
+    void setReadOnly(const bool value) { readOnly = value; }
+    [[nodiscard]] bool isReadOnly() const { return readOnly; }
 
     // Helper Methods
     void rebuildPatronBorrowedBooks();
 
-    // Core operations
+    // Change notifications, listeners aren't owned
+    void addListener(LibraryListener* listener);
+    void removeListener(LibraryListener* listener);
+
+    // Core operations. Checkout and return don't allocate (beyond growing the transaction log
+    // and the first time a patron or title shows up in the statistics)
+    // and don't save, callers decide when to persist.
     void addBook(Book* b);
     void addPatron(const Patron& p);
     void checkoutBook(int patronId, const std::string& title);
-    void returnBook(int patronId, const std::string& title);
-    Book* findBook(const std::string& title);
+    // If someone's waiting for the title the copy goes straight to them, returns who got it
+    std::optional<int> returnBook(int patronId, const std::string& title);
+    // Only when every copy is out. Returns the patron's place in the queue.
+    std::size_t placeHold(int patronId, const std::string& title);
+    [[nodiscard]] std::size_t holdsOn(const Book* book) const;
+    Book* findBook(const std::string& title);  // First copy of the title
+    [[nodiscard]] CopyCount copiesOf(const Book* book) const;
     Patron* findPatron(int id);
+    [[nodiscard]] Book* findBookById(int id) const;
+    std::vector<Patron*> findPatronsByName(const std::string& prefix, std::size_t limit = 10);
+    [[nodiscard]] std::vector<std::string> completeTitles(const std::string& prefix, std::size_t limit = 10) const;
 
     // Getters for GUI
     [[nodiscard]] const std::vector<Book*>& getBooks() const { return books; }
-    [[nodiscard]] const std::vector<Transaction>& getTransactions() const { return transactions; }
+    [[nodiscard]] const TransactionList& getTransactions() const { return catalog.transactions; }  // Call ensureTransactionsLoaded() first
     [[nodiscard]] const std::vector<Patron>& getPatrons() const { return patrons; }
 
+    // Point-in-time copy for background searches, saves and reports. Shares chunks with
+    // the live data, so it costs a pointer per 64 rows rather than a full copy.
+    [[nodiscard]] std::shared_ptr<const CatalogSnapshot> snapshot() const;
+
+    // Call counts and latency percentiles for the main operations, across all threads
+    [[nodiscard]] Metrics::Snapshot stats() const { return Metrics::collect(); }
+    void dumpStats(const std::string& filename = "Data/Stats.json") const;
+
+    // Heap bytes by category (see Stats/Memory.hpp). Walks every string, so it's O(catalog).
+    // Strings are counted once per live record, chunks an old snapshot cloned are counted but
+    // the strings inside them aren't.
+    [[nodiscard]] Memory::Snapshot memoryUsage() const;
+    void dumpMemoryUsage(const std::string& filename = "Data/Memory.json") const;
+
+    // Kept current on every checkout/return, rebuilt from the log when it's loaded
+    [[nodiscard]] const CirculationStats& circulationStats() const { return circulation; }
+
+    // "Also borrowed" suggestions, one book per title
+    [[nodiscard]] std::vector<Book*> alsoBorrowed(const Book* book, std::size_t k = 5) const;
+    [[nodiscard]] std::vector<Book*> recommendFor(int patronId, std::size_t k = 5) const;
+
+    // Combined predicates, planned against the genre/type/checked-out indexes
+    [[nodiscard]] std::vector<Book*> query(const Query& q) const;
+
+    // Best k matches first, pass the returned cursor back for the next page
+    [[nodiscard]] SearchPage searchBooksRanked(const std::string& term, SearchField field, std::size_t k,
+                                               const std::optional<SearchCursor>& after = std::nullopt) const;
+
+    // Typo-tolerant fallback for when the exact searches come up empty
+    [[nodiscard]] std::vector<Book*> fuzzySearch(const std::string& term, SearchField field, std::size_t limit = 50) const;
+
     // Search methods for GUI
     [[nodiscard]] std::vector<Book*> searchBooksByAuthor(const std::string& author) const;
     [[nodiscard]] std::vector<Book*> searchBooksByGenre(Book::Genre genre) const;
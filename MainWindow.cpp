@@ -1,4 +1,9 @@
 #include "MainWindow.hpp"
+#include "TransactionHistoryModel.hpp"
+#include "Stats/Reports.hpp"
+#include "Stats/ParallelScan.hpp"
+#include "Stats/Trace.hpp"
+#include <algorithm>
 #include <QMessageBox>
 #include <QInputDialog>
 #include <QLabel>
@@ -13,6 +18,9 @@
 #include <QPushButton>
 #include <QLineEdit>
 #include <QComboBox>
+#include <QCheckBox>
+#include <QDateEdit>
+#include <QFile>
 
 MainWindow::MainWindow(Library* lib, QWidget *parent)
     : QMainWindow(parent)
@@ -49,15 +57,38 @@ void MainWindow::setupUI() {
     searchTypeCombo->addItems({"Title", "Author", "Genre"});
     searchLayout->addWidget(searchTypeCombo);
 
+    auto* advancedButton = new QPushButton("Advanced...", searchGroup);
+    searchLayout->addWidget(advancedButton);
+    connect(advancedButton, &QPushButton::clicked, this, &MainWindow::onAdvancedSearchClicked);
+
     mainLayout->addWidget(searchGroup);
     connect(searchButton, &QPushButton::clicked, this, &MainWindow::onSearchClicked);
+    connect(searchEdit, &QLineEdit::returnPressed, this, &MainWindow::onSearchClicked);
+
+    // Search as you type, but wait for a pause in typing before starting
+    searchWorker = new SearchWorker(this);
+    connect(searchWorker, &SearchWorker::batchReady, this, &MainWindow::onSearchBatch);
+    connect(searchWorker, &SearchWorker::finished, this, &MainWindow::onSearchFinished);
+
+    searchDebounce = new QTimer(this);
+    searchDebounce->setSingleShot(true);
+    searchDebounce->setInterval(150);
+    connect(searchDebounce, &QTimer::timeout, this, &MainWindow::startSearch);
+    connect(searchEdit, &QLineEdit::textEdited, searchDebounce, qOverload<>(&QTimer::start));
+    connect(searchTypeCombo, &QComboBox::currentIndexChanged, searchDebounce, qOverload<>(&QTimer::start));
 
     // ===== Book Table =====
-    bookTable = new QTableWidget(centralWidget);
-    bookTable->setColumnCount(5);
-    QStringList headers;
-    headers << "Title" << "Author" << "Genre" << "Type" << "Status";
-    bookTable->setHorizontalHeaderLabels(headers);
+    bookModel = new BookTableModel(library, this);
+    bookProxy = new BookFilterProxyModel(this);
+    bookProxy->setSourceModel(bookModel);
+
+    // Scrolling to the bottom of a ranked search pulls in the next page
+    connect(bookModel, &BookTableModel::moreRequested, this, [this]() {
+        if (const quint64 page = searchWorker->fetchMore()) activeSearch = page;
+    });
+
+    bookTable = new QTableView(centralWidget);
+    bookTable->setModel(bookProxy);
 
     bookTable->setSortingEnabled(true);
     bookTable->horizontalHeader()->setSectionsClickable(true);
@@ -66,7 +97,7 @@ void MainWindow::setupUI() {
     // Screw CSS styling again BTW I hate this
     bookTable->setAlternatingRowColors(true);
     bookTable->setStyleSheet(
-        "QTableWidget {"
+        "QTableView {"
         "    alternate-background-color: #303234;"
         "    background-color: #18191a;"
         "}"
@@ -74,6 +105,29 @@ void MainWindow::setupUI() {
 
     bookTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
 
+    // Right click a book to list what its borrowers also took out
+    bookTable->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(bookTable, &QWidget::customContextMenuRequested, this, [this](const QPoint& pos) {
+        const QModelIndex index = bookTable->indexAt(pos);
+        if (!index.isValid()) return;
+        const Book* book = bookModel->bookAt(bookProxy->mapToSource(index).row());
+        if (!book) return;
+
+        QMenu menu(this);
+        const auto* alsoBorrowedAction = menu.addAction("Patrons Also Borrowed");
+        if (menu.exec(bookTable->viewport()->mapToGlobal(pos)) != alsoBorrowedAction) return;
+
+        if (!ensureTransactions()) return;
+        auto results = library->alsoBorrowed(book, 20);
+        const auto found = results.size();
+        searchWorker->cancel();
+        activeSearch = 0;
+        bookProxy->setFilter(BookFilterProxyModel::Filter::All);
+        bookModel->showBooks(std::move(results));
+        statusBar()->showMessage(QString("Patrons who borrowed '%1' also borrowed %2 titles")
+            .arg(QString::fromStdString(book->getTitle())).arg(found));
+    });
+
     mainLayout->addWidget(bookTable);
 
     // ===== Patron Lookup Section =====
@@ -84,9 +138,17 @@ void MainWindow::setupUI() {
     patronLayout->addWidget(lookupLabel);
 
     patronLookupEdit = new QLineEdit(patronGroup);
-    patronLookupEdit->setPlaceholderText("Enter ID number or full name...");
+    patronLookupEdit->setPlaceholderText("Enter ID number or name...");
     patronLayout->addWidget(patronLookupEdit);
 
+    // Suggestions come from the name index, the completer just shows them
+    patronSuggestions = new QStringListModel(patronGroup);
+    auto* patronCompleter = new QCompleter(patronSuggestions, patronGroup);
+    patronCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    patronCompleter->setCaseSensitivity(Qt::CaseInsensitive);
+    patronLookupEdit->setCompleter(patronCompleter);
+    connect(patronLookupEdit, &QLineEdit::textEdited, this, &MainWindow::onPatronLookupEdited);
+
     auto* lookupButton = new QPushButton("Lookup Patron", patronGroup);
     patronLayout->addWidget(lookupButton);
 
@@ -97,7 +159,7 @@ void MainWindow::setupUI() {
 
     // ===== Transactions Section =====
     // EVERY CHILD NEEDS A PARENT!!!
-    auto* inputGroup = new QGroupBox("Transaction", centralWidget);
+    auto* inputGroup = transactionGroup = new QGroupBox("Transaction", centralWidget);
     auto* inputGroupLayout = new QVBoxLayout(inputGroup);
     auto* formLayout = new QFormLayout();
 
@@ -109,6 +171,13 @@ void MainWindow::setupUI() {
     bookTitleEdit->setPlaceholderText("Enter book title");
     formLayout->addRow("Book Title:", bookTitleEdit);
 
+    titleSuggestions = new QStringListModel(inputGroup);
+    auto* titleCompleter = new QCompleter(titleSuggestions, inputGroup);
+    titleCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    titleCompleter->setCaseSensitivity(Qt::CaseInsensitive);
+    bookTitleEdit->setCompleter(titleCompleter);
+    connect(bookTitleEdit, &QLineEdit::textEdited, this, &MainWindow::onBookTitleEdited);
+
     inputGroupLayout->addLayout(formLayout);
 
     // Buttons
@@ -122,6 +191,10 @@ void MainWindow::setupUI() {
     connect(returnButton, &QPushButton::clicked, this, &MainWindow::onReturnClicked);
     actionButtons->addWidget(returnButton);
 
+    holdButton = new QPushButton("Place Hold", inputGroup);
+    connect(holdButton, &QPushButton::clicked, this, &MainWindow::onPlaceHoldClicked);
+    actionButtons->addWidget(holdButton);
+
     inputGroupLayout->addLayout(actionButtons);
 
     mainLayout->addWidget(inputGroup);
@@ -135,11 +208,11 @@ void MainWindow::setupUI() {
     connect(viewTransactionsButton, &QPushButton::clicked, this, &MainWindow::onViewTransactionsClicked);
     actionGroupLayout->addWidget(viewTransactionsButton);
 
-    auto* addPatronButton = new QPushButton("Add New Patron", actionGroup);
+    addPatronButton = new QPushButton("Add New Patron", actionGroup);
     connect(addPatronButton, &QPushButton::clicked, this, &MainWindow::onAddPatronClicked);
     actionGroupLayout->addWidget(addPatronButton);
 
-    auto* addBookButton = new QPushButton("Add New Book", actionGroup);
+    addBookButton = new QPushButton("Add New Book", actionGroup);
     connect(addBookButton, &QPushButton::clicked, this, &MainWindow::onAddBookClicked);
     actionGroupLayout->addWidget(addBookButton);
 
@@ -162,7 +235,7 @@ void MainWindow::setupMenuBar()
     // File menu
     auto* fileMenu = menuBar()->addMenu("&File");
 
-    const auto* saveAction = fileMenu->addAction("&Save Data");
+    saveAction = fileMenu->addAction("&Save Data");
     connect(saveAction, &QAction::triggered, this, [this]() {
         try {
             library->saveData();
@@ -172,6 +245,17 @@ void MainWindow::setupMenuBar()
         }
     });
 
+    const auto* exportAction = fileMenu->addAction("&Export Transactions as Text");
+    connect(exportAction, &QAction::triggered, this, [this]() {
+        try {
+            library->ensureTransactionsLoaded();
+            library->exportTransactions();
+            statusBar()->showMessage("Transactions exported to Data/Transactions.txt", 3000);
+        } catch (const std::exception& e) {
+            QMessageBox::warning(this, "Error", QString("Failed to export: ") + e.what());
+        }
+    });
+
     fileMenu->addSeparator();
 
     const auto* exitAction = fileMenu->addAction("E&xit");
@@ -181,73 +265,44 @@ void MainWindow::setupMenuBar()
     auto* viewMenu = menuBar()->addMenu("&View");
 
     const auto* availableAction = viewMenu->addAction("Available Books Only");
-    connect(availableAction, &QAction::triggered, this, [this]() {
-        bookTable->setRowCount(0);
-        for (const auto& books = library->getBooks(); const auto& book : books) {
-            if (book->getStatus() == Book::BookStatus::Available) {
-                const int row = bookTable->rowCount();
-                bookTable->insertRow(row);
-                bookTable->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(book->getTitle())));
-                bookTable->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(book->getAuthor())));
-                bookTable->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(Book::genreToString(book->getGenre()))));
-                bookTable->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(book->getType())));
-                bookTable->setItem(row, 4, new QTableWidgetItem("Available"));
-            }
-        }
-    });
+    connect(availableAction, &QAction::triggered, this, [this]() { showFilteredBooks(BookFilterProxyModel::Filter::Available); });
 
     const auto* checkedOutAction = viewMenu->addAction("Checked Out Books Only");
-    connect(checkedOutAction, &QAction::triggered, this, [this]() {
-        bookTable->setRowCount(0);
-        for (const auto& books = library->getBooks(); const auto& book : books) {
-            if (book->getStatus() == Book::BookStatus::CheckedOut) {
-                const int row = bookTable->rowCount();
-                bookTable->insertRow(row);
-                bookTable->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(book->getTitle())));
-                bookTable->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(book->getAuthor())));
-                bookTable->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(Book::genreToString(book->getGenre()))));
-                bookTable->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(book->getType())));
-                bookTable->setItem(row, 4, new QTableWidgetItem("Checked Out"));
-            }
-        }
-    });
+    connect(checkedOutAction, &QAction::triggered, this, [this]() { showFilteredBooks(BookFilterProxyModel::Filter::CheckedOut); });
 
     const auto* printedBookAction = viewMenu->addAction("Printed Books Only");
-    connect(printedBookAction, &QAction::triggered, this, [this]() {
-        bookTable->setRowCount(0);
-        for (const auto& books = library->getBooks(); const auto& book : books) {
-            if (!book->getType().find("Printed Book")) {
-                const int row = bookTable->rowCount();
-                bookTable->insertRow(row);
-                bookTable->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(book->getTitle())));
-                bookTable->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(book->getAuthor())));
-                bookTable->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(Book::genreToString(book->getGenre()))));
-                bookTable->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(book->getType())));
-                QString status = (book->getStatus() == Book::BookStatus::Available) ? "Available" : "Checked Out";
-                bookTable->setItem(row, 4, new QTableWidgetItem(status));
-            }
-        }
-    });
+    connect(printedBookAction, &QAction::triggered, this, [this]() { showFilteredBooks(BookFilterProxyModel::Filter::Printed); });
 
     const auto* EBookAction = viewMenu->addAction("E-Books Only");
-    connect(EBookAction, &QAction::triggered, this, [this]() {
-        bookTable->setRowCount(0);
-        for (const auto& books = library->getBooks(); const auto& book : books) {
-            if (!book->getType().find("E-Book")) {
-                const int row = bookTable->rowCount();
-                bookTable->insertRow(row);
-                bookTable->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(book->getTitle())));
-                bookTable->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(book->getAuthor())));
-                bookTable->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(Book::genreToString(book->getGenre()))));
-                bookTable->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(book->getType())));
-                QString status = (book->getStatus() == Book::BookStatus::Available) ? "Available" : "Checked Out";
-                bookTable->setItem(row, 4, new QTableWidgetItem(status));
-            }
-        }
+    connect(EBookAction, &QAction::triggered, this, [this]() { showFilteredBooks(BookFilterProxyModel::Filter::EBook); });
+
+    const auto* overdueAction = viewMenu->addAction("Overdue Books Only");
+    connect(overdueAction, &QAction::triggered, this, [this]() {
+        auto results = library->query(Query::overdue());
+        const auto found = results.size();
+        searchWorker->cancel();
+        activeSearch = 0;
+        bookProxy->setFilter(BookFilterProxyModel::Filter::All);
+        bookModel->showBooks(std::move(results));
+        statusBar()->showMessage(QString("Displaying %1 overdue books").arg(found), 3000);
     });
 
     viewMenu->addSeparator();
 
+    const auto* statisticsAction = viewMenu->addAction("Circulation &Statistics...");
+    connect(statisticsAction, &QAction::triggered, this, &MainWindow::onViewStatisticsClicked);
+
+    const auto* historyReportAction = viewMenu->addAction("&History Report...");
+    connect(historyReportAction, &QAction::triggered, this, &MainWindow::onViewHistoryReportClicked);
+
+    const auto* performanceAction = viewMenu->addAction("&Performance Statistics...");
+    connect(performanceAction, &QAction::triggered, this, &MainWindow::onViewPerformanceClicked);
+
+    const auto* memoryAction = viewMenu->addAction("&Memory Usage...");
+    connect(memoryAction, &QAction::triggered, this, &MainWindow::onViewMemoryClicked);
+
+    viewMenu->addSeparator();
+
     const auto* allBooksAction = viewMenu->addAction("All Books");
     connect(allBooksAction, &QAction::triggered, this, &MainWindow::refreshBookTable);
 
@@ -334,6 +389,23 @@ void MainWindow::displayPatronInfo(const Patron* patron) {
         layout->addWidget(booksTable);
     }
 
+    // Suggestions from what other patrons borrowed alongside this patron's books
+    ensureTransactions();
+    const auto recommended = library->recommendFor(patron->getId());
+    if (!recommended.empty()) {
+        QLabel* recommendHeader = new QLabel("You Might Also Like:", &dialog);
+        recommendHeader->setStyleSheet("font-size: 14px; font-weight: bold;");
+        layout->addWidget(recommendHeader);
+
+        QStringList lines;
+        for (const Book* book : recommended)
+            lines << QString("%1 by %2").arg(QString::fromStdString(book->getTitle()), QString::fromStdString(book->getAuthor()));
+
+        QLabel* recommendLabel = new QLabel(lines.join("\n"), &dialog);
+        recommendLabel->setStyleSheet("margin-left: 10px;");
+        layout->addWidget(recommendLabel);
+    }
+
     layout->addStretch();
 
     // Close button
@@ -356,49 +428,166 @@ void MainWindow::displayPatronInfo(const Patron* patron) {
 }
 
 void MainWindow::refreshBookTable() {
-    bookTable->setRowCount(0);
-
-    const auto& books = library->getBooks();
-    for (const auto& book : books) {
-        const int row = bookTable->rowCount();
-        bookTable->insertRow(row);
-
-        bookTable->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(book->getTitle())));
-        bookTable->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(book->getAuthor())));
-        bookTable->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(Book::genreToString(book->getGenre()))));
-        bookTable->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(book->getType())));
-
-        QString status;
-        if (book->getStatus() == Book::BookStatus::Available) status = "Available";
-        else {
-            status = "Checked Out";
-            if (book->isOverdue()) status += " - OVERDUE!";
+    Trace::Span span("refreshBookTable", "gui");
+    searchWorker->cancel();
+    activeSearch = 0;
+    bookProxy->setFilter(BookFilterProxyModel::Filter::All);
+    bookModel->showAll();
+
+    statusBar()->showMessage(QString("Displaying %1 books").arg(library->getBooks().size()), 3000);
+}
+
+void MainWindow::loadCatalogInBackground() {
+    if (!loader) {
+        loader = new CatalogLoader(library, this);
+
+        connect(loader, &CatalogLoader::progress, this, [this](const qint64 loaded, const qint64 total) {
+            loadProgress->setMaximum(static_cast<int>(std::max<qint64>(total, 1)));
+            loadProgress->setValue(static_cast<int>(loaded));
+        });
+
+        connect(loader, &CatalogLoader::finished, this, [this](const bool ok, const QString& error) {
+            statusBar()->removeWidget(loadProgress);
+            loadProgress->deleteLater();
+            loadProgress = nullptr;
+            setEditingEnabled(true);
+
+            if (!ok) QMessageBox::warning(this, "Error", "Failed to load data: " + error);
+            else watchBooksFile();
+
+            if (ok && !shipDirectory.isEmpty()) {
+                try {
+                    library->shipChangesTo(shipDirectory.toStdString());
+                } catch (const std::exception& e) {
+                    QMessageBox::warning(this, "Error", QString("Failed to start shipping changes: ") + e.what());
+                }
+            }
+            statusBar()->showMessage(QString("Loaded %1 books and %2 patrons")
+                .arg(library->getBooks().size()).arg(library->getPatrons().size()), 3000);
+        });
+    }
+    if (loader->isLoading()) return;
+
+    loadProgress = new QProgressBar(this);
+    loadProgress->setMaximumWidth(250);
+    loadProgress->setFormat("Loading books... %p%");
+    statusBar()->addPermanentWidget(loadProgress);
+
+    setEditingEnabled(false);
+    loader->start();
+}
+
+void MainWindow::shipChangesTo(const QString& directory) {
+    shipDirectory = directory;
+}
+
+void MainWindow::followPrimary(const QString& directory) {
+    replica = std::make_unique<Replication::Replica>(*library, directory.toStdString());
+    setEditingEnabled(false);
+    setWindowTitle(windowTitle() + " (read-only)");
+
+    replicaStatus = new QLabel("Waiting for the primary...", this);
+    statusBar()->addPermanentWidget(replicaStatus);
+
+    // Lag is at most this plus the time to apply a batch
+    replicaPoll = new QTimer(this);
+    replicaPoll->setInterval(200);
+    connect(replicaPoll, &QTimer::timeout, this, &MainWindow::onReplicaPoll);
+    replicaPoll->start();
+    onReplicaPoll();
+}
+
+void MainWindow::onReplicaPoll() {
+    try {
+        const bool wasReady = replica->isReady();
+        const std::size_t applied = replica->poll();
+
+        if (!replica->isReady()) {
+            replicaStatus->setText("Waiting for the primary...");
+            return;
+        }
+        if (!wasReady) {
+            statusBar()->showMessage(QString("Following the primary, %1 books").arg(library->getBooks().size()), 3000);
         }
+        if (applied > 0 || !wasReady) {
+            replicaStatus->setText(QString("Replica at change %1, %2 ms behind")
+                .arg(replica->appliedSequence()).arg(replica->lastLagMillis()));
+        }
+    } catch (const std::exception& e) {
+        replicaStatus->setText(QString("Replication error: ") + e.what());
+    }
+}
+
+void MainWindow::watchBooksFile() {
+    if (!booksWatcher) {
+        booksWatcher = new QFileSystemWatcher(this);
 
-        bookTable->setItem(row, 4, new QTableWidgetItem(status));
+        // Saves come in bursts (and editors write a temp file then rename), let them settle first
+        reloadDebounce = new QTimer(this);
+        reloadDebounce->setSingleShot(true);
+        reloadDebounce->setInterval(250);
+        connect(booksWatcher, &QFileSystemWatcher::fileChanged, reloadDebounce, qOverload<>(&QTimer::start));
+        connect(reloadDebounce, &QTimer::timeout, this, &MainWindow::onBooksFileChanged);
     }
 
-    statusBar()->showMessage(QString("Displaying %1 books").arg(books.size()), 3000);
+    // A renamed-over file isn't watched anymore, so this gets called again after every change
+    const QString path = "Data/Books.txt";
+    if (!booksWatcher->files().contains(path) && QFile::exists(path)) booksWatcher->addPath(path);
 }
 
-void MainWindow::onSearchClicked() {
-    const QString term = searchEdit->text();
-    const QString type = searchTypeCombo->currentText();
+void MainWindow::onBooksFileChanged() {
+    watchBooksFile();
+    if (library->isLoading()) return;
 
-    if (term.isEmpty()) {
-        refreshBookTable();
-        return;
+    try {
+        const BookReload changes = library->reloadBooks();
+        if (changes.empty()) return;  // Most of the time it's just our own save
+
+        statusBar()->showMessage(QString("Books.txt changed on disk: %1 added, %2 changed, %3 removed")
+            .arg(changes.added).arg(changes.changed).arg(changes.removed), 5000);
+    } catch (const std::exception& e) {
+        statusBar()->showMessage(QString("Couldn't reload Books.txt: ") + e.what(), 5000);
     }
+}
+
+void MainWindow::setEditingEnabled(const bool enabled) {
+    // Anything that adds to or saves the catalog has to wait for the whole of it
+    transactionGroup->setEnabled(enabled);
+    addPatronButton->setEnabled(enabled);
+    addBookButton->setEnabled(enabled);
+    saveAction->setEnabled(enabled);
+}
 
-    bookTable->setRowCount(0);
+bool MainWindow::ensureTransactions() {
+    if (library->transactionsLoaded()) return true;
 
-    std::vector<Book*> results;
-    if (type == "Title") results = library->searchBooksByTitle(term.toStdString());
-    else if (type == "Author") results = library->searchBooksByAuthor(term.toStdString());
-    else if (type == "Genre") {
+    try {
+        statusBar()->showMessage("Loading transaction history...");
+        library->ensureTransactionsLoaded();
+        statusBar()->clearMessage();
+        return true;
+    } catch (const std::exception& e) {
+        QMessageBox::warning(this, "Error", QString("Failed to load transactions: ") + e.what());
+        return false;
+    }
+}
+
+void MainWindow::showFilteredBooks(const BookFilterProxyModel::Filter filter) {
+    searchWorker->cancel();
+    activeSearch = 0;
+    bookModel->showAll();
+    bookProxy->setFilter(filter);
+
+    statusBar()->showMessage(QString("Displaying %1 books").arg(bookProxy->rowCount()), 3000);
+}
+
+void MainWindow::onSearchClicked() {
+    searchDebounce->stop();
+
+    // Pressing the button is the only time a bad genre deserves a popup
+    if (const QString term = searchEdit->text(); !term.isEmpty() && searchTypeCombo->currentText() == "Genre") {
         try {
-            Book::Genre genre = Book::stringToGenre(term.toStdString());
-            results = library->searchBooksByGenre(genre);
+            Book::stringToGenre(term.toStdString());
         } catch (...) {
             QMessageBox::warning(this, "Invalid Genre.",
             "Please enter a valid genre (Fiction, NonFiction, Mystery, Science, Biography)");
@@ -407,26 +596,135 @@ void MainWindow::onSearchClicked() {
         }
     }
 
-    for (const auto& book : results) {
-        const int row = bookTable->rowCount();
-        bookTable->insertRow(row);
+    startSearch();
+}
 
-        bookTable->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(book->getTitle())));
-        bookTable->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(book->getAuthor())));
-        bookTable->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(Book::genreToString(book->getGenre()))));
-        bookTable->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(book->getType())));
+void MainWindow::onAdvancedSearchClicked() {
+    QDialog dialog(this);
+    dialog.setWindowTitle("Advanced Search");
 
-        QString status;
-        if (book->getStatus() == Book::BookStatus::Available) status = "Available";
-        else {
-            status = "Checked Out";
-            if (book->isOverdue()) status += " - OVERDUE!";
-        }
+    QFormLayout form(&dialog);
+
+    QLineEdit titleEdit(&dialog);
+    titleEdit.setPlaceholderText("Title contains...");
+    form.addRow("Title:", &titleEdit);
+
+    QLineEdit authorEdit(&dialog);
+    authorEdit.setPlaceholderText("Author contains...");
+    form.addRow("Author:", &authorEdit);
 
-        bookTable->setItem(row, 4, new QTableWidgetItem(status));
+    QComboBox genreCombo(&dialog);
+    genreCombo.addItems({"Any", "Fiction", "Non-Fiction", "Mystery", "Science", "Biography"});
+    form.addRow("Genre:", &genreCombo);
+
+    QComboBox statusCombo(&dialog);
+    statusCombo.addItems({"Any", "Available", "Checked Out"});
+    form.addRow("Status:", &statusCombo);
+
+    QComboBox typeCombo(&dialog);
+    typeCombo.addItems({"Any", "Printed Book", "E-Book"});
+    form.addRow("Type:", &typeCombo);
+
+    QCheckBox overdueCheck("Overdue only", &dialog);
+    form.addRow("", &overdueCheck);
+
+    QCheckBox dueBeforeCheck("Due before", &dialog);
+    QDateEdit dueBeforeEdit(QDate::currentDate().addDays(7), &dialog);
+    dueBeforeEdit.setCalendarPopup(true);
+    form.addRow(&dueBeforeCheck, &dueBeforeEdit);
+
+    QComboBox matchCombo(&dialog);
+    matchCombo.addItems({"All conditions", "Any condition"});
+    form.addRow("Match:", &matchCombo);
+
+    QDialogButtonBox buttons(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    form.addRow(&buttons);
+
+    QObject::connect(&buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    QObject::connect(&buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+
+    if (dialog.exec() != QDialog::Accepted) return;
+
+    std::vector<Query> conditions;
+    if (!titleEdit.text().isEmpty()) conditions.push_back(Query::titleContains(titleEdit.text().toStdString()));
+    if (!authorEdit.text().isEmpty()) conditions.push_back(Query::authorContains(authorEdit.text().toStdString()));
+    if (genreCombo.currentIndex() > 0) conditions.push_back(Query::genreIs(Book::stringToGenre(genreCombo.currentText().toStdString())));
+    if (statusCombo.currentIndex() == 1) conditions.push_back(Query::statusIs(Book::BookStatus::Available));
+    if (statusCombo.currentIndex() == 2) conditions.push_back(Query::statusIs(Book::BookStatus::CheckedOut));
+    if (typeCombo.currentIndex() == 1) conditions.push_back(Query::typeIs(BookKind::Printed));
+    if (typeCombo.currentIndex() == 2) conditions.push_back(Query::typeIs(BookKind::EBook));
+    if (overdueCheck.isChecked()) conditions.push_back(Query::overdue());
+    if (dueBeforeCheck.isChecked()) {
+        const QDate d = dueBeforeEdit.date();
+        conditions.push_back(Query::dueBefore(Date(d.day(), d.month(), d.year())));
     }
 
-    statusBar()->showMessage(QString("Found %1 books.").arg(results.size()));
+    if (conditions.empty()) {
+        refreshBookTable();
+        return;
+    }
+
+    const Query q = matchCombo.currentIndex() == 0 ? Query::allOf(std::move(conditions))
+                                                   : Query::anyOf(std::move(conditions));
+
+    searchWorker->cancel();
+    activeSearch = 0;
+
+    auto results = library->query(q);
+    const auto found = results.size();
+    bookProxy->setFilter(BookFilterProxyModel::Filter::All);
+    bookModel->showBooks(std::move(results));
+    statusBar()->showMessage(QString("Found %1 books.").arg(found));
+}
+
+void MainWindow::startSearch() {
+    Trace::Span span("startSearch", "gui");
+    const QString term = searchEdit->text();
+    const QString type = searchTypeCombo->currentText();
+
+    if (term.isEmpty()) {
+        searchWorker->cancel();
+        activeSearch = 0;
+        refreshBookTable();
+        return;
+    }
+
+    SearchWorker::Field field = SearchWorker::Field::Title;
+    if (type == "Author") field = SearchWorker::Field::Author;
+    else if (type == "Genre") field = SearchWorker::Field::Genre;
+
+    bookProxy->setFilter(BookFilterProxyModel::Filter::All);
+    bookModel->showBooks({});
+
+    // Keep the ranking order until someone clicks a column header
+    bookTable->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    bookProxy->sort(-1);
+
+    activeSearch = searchWorker->start(library->snapshot(), field, term.toStdString());
+    statusBar()->showMessage("Searching...");
+}
+
+void MainWindow::onSearchBatch(const quint64 generation, const QList<int>& bookIds) {
+    if (generation != activeSearch) return;
+
+    std::vector<Book*> batch;
+    batch.reserve(bookIds.size());
+    for (const int id : bookIds) {
+        if (Book* book = library->findBookById(id)) batch.push_back(book);
+    }
+    bookModel->appendBooks(batch);
+}
+
+void MainWindow::onSearchFinished(const quint64 generation, const int total, const bool hasMore, const bool closeMatches) {
+    if (generation != activeSearch) return;
+    bookModel->setMoreAvailable(hasMore);
+
+    if (closeMatches) {
+        statusBar()->showMessage(QString("No exact matches, showing %1 close matches.").arg(total));
+        return;
+    }
+
+    statusBar()->showMessage(QString("Found %1 books.").arg(total));
 }
 
 void MainWindow::onLookupPatronClicked() {
@@ -451,27 +749,57 @@ void MainWindow::onLookupPatronClicked() {
             return;
         }
     } else {
-        // Lookup by name
-        const auto& patrons = library->getPatrons();
-        const QString searchName = input.toLower();
-
-        for (auto& patron : patrons) {
-            if (QString patronName = QString::fromStdString(patron.getName()).toLower(); patronName == searchName) {
-                foundPatron = const_cast<Patron*>(&patron);
-                break;
-            }
-        }
+        // Lookup by name, exact matches come back first
+        const auto matches = library->findPatronsByName(input.toStdString(), 20);
 
-        if (!foundPatron) {
+        if (matches.empty()) {
             QMessageBox::information(this, "Not Found",
                 QString("No patron found with name: %1").arg(input));
             return;
         }
+
+        if (QString::fromStdString(matches.front()->getName()).compare(input, Qt::CaseInsensitive) == 0 || matches.size() == 1) {
+            foundPatron = matches.front();
+        } else {
+            QStringList choices;
+            for (const auto* patron : matches)
+                choices << QString("%1 (ID: %2)").arg(QString::fromStdString(patron->getName())).arg(patron->getId());
+
+            bool ok;
+            const QString choice = QInputDialog::getItem(this, "Select Patron",
+                "Several patrons match that name:", choices, 0, false, &ok);
+            if (!ok) return;
+            foundPatron = matches[choices.indexOf(choice)];
+        }
     }
 
     displayPatronInfo(foundPatron);
 }
 
+void MainWindow::onPatronLookupEdited(const QString& text) {
+    const QString input = text.trimmed();
+
+    bool isId;
+    input.toInt(&isId);
+    if (input.isEmpty() || isId) {
+        patronSuggestions->setStringList({});
+        return;
+    }
+
+    QStringList names;
+    for (const auto* patron : library->findPatronsByName(input.toStdString(), 10))
+        names << QString::fromStdString(patron->getName());
+    patronSuggestions->setStringList(names);
+}
+
+void MainWindow::onBookTitleEdited(const QString& text) {
+    QStringList titles;
+    if (!text.isEmpty()) {
+        for (const auto& title : library->completeTitles(text.toStdString(), 10)) titles << QString::fromStdString(title);
+    }
+    titleSuggestions->setStringList(titles);
+}
+
 void MainWindow::onCheckoutClicked() {
     const QString patronIdText = patronIdEdit->text();
     const QString bookTitle = bookTitleEdit->text();
@@ -491,7 +819,7 @@ void MainWindow::onCheckoutClicked() {
     // Proper saving/loading to ensure refresh is still allowed
     try {
         library->checkoutBook(patronId, bookTitle.toStdString());
-        refreshBookTable();
+        library->saveDataInBackground();
     } catch (const std::exception& e) {
         QMessageBox::warning(this, "Checkout Failed", QString("Error: ") + e.what());
     }
@@ -515,17 +843,53 @@ void MainWindow::onReturnClicked()
     }
 
     try {
-        library->returnBook(patronId, bookTitle.toStdString());
-        refreshBookTable();
+        const auto promoted = library->returnBook(patronId, bookTitle.toStdString());
+        library->saveDataInBackground();
         patronIdEdit->clear();
         bookTitleEdit->clear();
-        statusBar()->showMessage("Book returned successfully!", 3000);
+
+        if (promoted) {
+            const Patron* next = library->findPatron(*promoted);
+            QMessageBox::information(this, "Hold Filled",
+                QString("'%1' was on hold and has been checked out to %2 (ID: %3).")
+                    .arg(bookTitle, next ? QString::fromStdString(next->getName()) : QString())
+                    .arg(*promoted));
+        } else {
+            statusBar()->showMessage("Book returned successfully!", 3000);
+        }
     } catch (const std::exception& e) {
         QMessageBox::warning(this, "Return Failed", QString("Error: ") + e.what());
     }
 }
 
+void MainWindow::onPlaceHoldClicked()
+{
+    const QString patronIdText = patronIdEdit->text();
+    const QString bookTitle = bookTitleEdit->text();
+
+    if (patronIdText.isEmpty() || bookTitle.isEmpty()) {
+        QMessageBox::warning(this, "Input Error", "Please enter both Patron ID and Book Title.");
+        return;
+    }
+
+    bool ok;
+    const int patronId = patronIdText.toInt(&ok);
+    if (!ok) {
+        QMessageBox::warning(this, "Input Error", "Patron ID must be a number.");
+        return;
+    }
+
+    try {
+        const std::size_t position = library->placeHold(patronId, bookTitle.toStdString());
+        library->saveDataInBackground();
+        statusBar()->showMessage(QString("Hold placed, patron is number %1 in line.").arg(position), 3000);
+    } catch (const std::exception& e) {
+        QMessageBox::warning(this, "Hold Failed", QString("Error: ") + e.what());
+    }
+}
+
 void MainWindow::onViewTransactionsClicked() {
+    if (!ensureTransactions()) return;
     const auto& transactions = library->getTransactions();
 
     if (transactions.empty()) {
@@ -543,9 +907,10 @@ void MainWindow::onViewTransactionsClicked() {
     titleLabel->setStyleSheet("font-size: 14px; font-weight: bold; margin: 5px;");
     layout->addWidget(titleLabel);
 
-    QTableWidget* table = new QTableWidget(&dialog);
-    table->setColumnCount(5);
-    table->setHorizontalHeaderLabels({"Date", "Patron ID", "Type", "Book Title", "Status"});
+    // Rows are fetched in pages as the view scrolls, nothing is built up front
+    auto* model = new TransactionHistoryModel(library, &dialog);
+    auto* table = new QTableView(&dialog);
+    table->setModel(model);
 
     table->setSortingEnabled(true);
     table->horizontalHeader()->setSectionsClickable(true);
@@ -556,42 +921,333 @@ void MainWindow::onViewTransactionsClicked() {
     table->setColumnWidth(4, 300);
 
     table->setAlternatingRowColors(true);
-    table->setRowCount(transactions.size());
     table->setStyleSheet(
-        "QTableWidget {"
+        "QTableView {"
         "    alternate-background-color: #303234;"
         "    background-color: #18191a;"
         "}"
     );
 
-    int row = 0;
-    for (const auto& t : transactions) {
-        table->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(t.getDate().toString())));
-        table->setItem(row, 1, new QTableWidgetItem(QString::number(t.getPatronID())));
-        table->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(t.typeToString())));
-        table->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(t.getBookTitle())));
-
-        // Show current status for checkouts
-        if (t.getType() == TransactionType::Checkout) {
-            if (const Book* book = library->findBook(t.getBookTitle()); book && book->getStatus() == Book::BookStatus::CheckedOut && book->getCurrentPatronId() == t.getPatronID()) {
-                QString statusText = "Active";
-                if (book->isOverdue()) statusText += " - OVERDUE!";
-                if (book->getDueDate().has_value()) statusText += " (Due: " + QString::fromStdString(book->getDueDate()->toString()) + ")";
-                table->setItem(row, 4, new QTableWidgetItem(statusText));
-            } else {
-                table->setItem(row, 4, new QTableWidgetItem("Returned"));
-            }
-        } else {
-            table->setItem(row, 4, new QTableWidgetItem("Completed"));
+    layout->addWidget(table);
+
+    auto* closeButton = new QPushButton("Close", &dialog);
+    connect(closeButton, &QPushButton::clicked, &dialog, &QDialog::accept);
+    layout->addWidget(closeButton, 0, Qt::AlignRight);
+
+    dialog.exec();
+}
+
+// Everything here is read straight off the running counters, nothing replays the log
+void MainWindow::onViewStatisticsClicked() {
+    if (!ensureTransactions()) return;
+    const CirculationStats& stats = library->circulationStats();
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Circulation Statistics");
+    dialog.resize(700, 600);
+
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+
+    QLabel* summaryLabel = new QLabel(
+        QString("Active loans: %1 across %2 patrons\nAverage loan: %3 days over %4 returned loans")
+            .arg(stats.activeLoans())
+            .arg(stats.patronsWithActiveLoans())
+            .arg(stats.averageLoanDays(), 0, 'f', 1)
+            .arg(stats.loansCompleted()),
+        &dialog);
+    summaryLabel->setStyleSheet("font-size: 14px; font-weight: bold; margin: 5px;");
+    layout->addWidget(summaryLabel);
+
+    const QString tableStyle =
+        "QTableWidget {"
+        "    alternate-background-color: #303234;"
+        "    background-color: #18191a;"
+        "}";
+
+    // Most borrowed titles
+    layout->addWidget(new QLabel("Most Borrowed:", &dialog));
+
+    const auto& top = stats.mostBorrowed();
+    QTableWidget* topTable = new QTableWidget(static_cast<int>(top.size()), 3, &dialog);
+    topTable->setHorizontalHeaderLabels({"Title", "Author", "Checkouts"});
+    topTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    topTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+    topTable->verticalHeader()->setVisible(false);
+    topTable->setAlternatingRowColors(true);
+    topTable->setStyleSheet(tableStyle);
+
+    for (int i = 0; i < static_cast<int>(top.size()); ++i) {
+        const Book* book = library->findBookById(top[i].titleId);
+        topTable->setItem(i, 0, new QTableWidgetItem(book ? QString::fromStdString(book->getTitle()) : QString("#%1").arg(top[i].titleId)));
+        topTable->setItem(i, 1, new QTableWidgetItem(book ? QString::fromStdString(book->getAuthor()) : QString()));
+        topTable->setItem(i, 2, new QTableWidgetItem(QString::number(top[i].checkouts)));
+    }
+    layout->addWidget(topTable);
+
+    // Checkouts per genre over the last week, newest day first
+    constexpr int DAYS = 7;
+    layout->addWidget(new QLabel("Checkouts per Genre, Last 7 Days:", &dialog));
+
+    QTableWidget* genreTable = new QTableWidget(DAYS, static_cast<int>(CirculationStats::GENRE_COUNT), &dialog);
+    QStringList genreNames;
+    for (const std::string_view name : Book::GENRE_NAMES) genreNames << QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size()));
+    genreTable->setHorizontalHeaderLabels(genreNames);
+    genreTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    genreTable->setAlternatingRowColors(true);
+    genreTable->setStyleSheet(tableStyle);
+
+    const int today = Date().toDayNumber();
+    QStringList dayNames;
+    for (int i = 0; i < DAYS; ++i) {
+        dayNames << QString::fromStdString(Date::fromDayNumber(today - i).toString());
+        for (std::size_t g = 0; g < CirculationStats::GENRE_COUNT; ++g) {
+            const auto count = stats.checkoutsOn(today - i, static_cast<Book::Genre>(g));
+            genreTable->setItem(i, static_cast<int>(g), new QTableWidgetItem(QString::number(count)));
         }
+    }
+    genreTable->setVerticalHeaderLabels(dayNames);
+    layout->addWidget(genreTable);
+
+    auto* closeButton = new QPushButton("Close", &dialog);
+    connect(closeButton, &QPushButton::clicked, &dialog, &QDialog::accept);
+    layout->addWidget(closeButton, 0, Qt::AlignRight);
+
+    dialog.exec();
+}
+
+// Full scans of the log, run over a snapshot on every core
+void MainWindow::onViewHistoryReportClicked() {
+    if (!ensureTransactions()) return;
+    const auto snapshot = library->snapshot();
+    const unsigned threads = scanThreads();
+
+    const auto trends = Reports::genreTrendsByMonth(*snapshot, threads);
+    const auto frequency = Reports::borrowingFrequency(*snapshot, threads);
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("History Report");
+    dialog.resize(700, 600);
+
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+
+    const QString tableStyle =
+        "QTableWidget {"
+        "    alternate-background-color: #303234;"
+        "    background-color: #18191a;"
+        "}";
+
+    // Checkouts per genre for each month, newest first
+    layout->addWidget(new QLabel("Genre Trends by Month:", &dialog));
+
+    QTableWidget* trendTable = new QTableWidget(static_cast<int>(trends.size()), static_cast<int>(CirculationStats::GENRE_COUNT), &dialog);
+    QStringList genreNames;
+    for (const std::string_view name : Book::GENRE_NAMES) genreNames << QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size()));
+    trendTable->setHorizontalHeaderLabels(genreNames);
+    trendTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    trendTable->setAlternatingRowColors(true);
+    trendTable->setStyleSheet(tableStyle);
+
+    QStringList monthNames;
+    int row = 0;
+    for (auto it = trends.rbegin(); it != trends.rend(); ++it, ++row) {
+        monthNames << QString("%1/%2").arg(it->first % 12 + 1, 2, 10, QChar('0')).arg(it->first / 12);
+        for (std::size_t g = 0; g < CirculationStats::GENRE_COUNT; ++g)
+            trendTable->setItem(row, static_cast<int>(g), new QTableWidgetItem(QString::number(it->second[g])));
+    }
+    trendTable->setVerticalHeaderLabels(monthNames);
+    layout->addWidget(trendTable);
+
+    // Checkouts per patron, sortable
+    layout->addWidget(new QLabel("Borrowing Frequency by Patron:", &dialog));
+
+    QTableWidget* patronTable = new QTableWidget(static_cast<int>(frequency.size()), 3, &dialog);
+    patronTable->setHorizontalHeaderLabels({"Patron ID", "Name", "Checkouts"});
+    patronTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+    patronTable->verticalHeader()->setVisible(false);
+    patronTable->setAlternatingRowColors(true);
+    patronTable->setStyleSheet(tableStyle);
+
+    row = 0;
+    for (const auto& [patronId, checkouts] : frequency) {
+        const Patron* patron = library->findPatron(patronId);
+        auto* idItem = new QTableWidgetItem();
+        idItem->setData(Qt::DisplayRole, patronId);
+        auto* countItem = new QTableWidgetItem();
+        countItem->setData(Qt::DisplayRole, static_cast<int>(checkouts));
+
+        patronTable->setItem(row, 0, idItem);
+        patronTable->setItem(row, 1, new QTableWidgetItem(patron ? QString::fromStdString(patron->getName()) : QString()));
+        patronTable->setItem(row, 2, countItem);
         row++;
     }
+    patronTable->setSortingEnabled(true);
+    patronTable->sortByColumn(2, Qt::DescendingOrder);
+    layout->addWidget(patronTable);
 
+    auto* closeButton = new QPushButton("Close", &dialog);
+    connect(closeButton, &QPushButton::clicked, &dialog, &QDialog::accept);
+    layout->addWidget(closeButton, 0, Qt::AlignRight);
+
+    dialog.exec();
+}
+
+void MainWindow::onViewPerformanceClicked() {
+    QDialog dialog(this);
+    dialog.setWindowTitle("Performance Statistics");
+    dialog.resize(800, 400);
+
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+
+    QTableWidget* table = new QTableWidget(static_cast<int>(Metrics::OP_COUNT), 7, &dialog);
+    table->setHorizontalHeaderLabels({"Operation", "Calls", "Mean", "p50", "p90", "p99", "Max"});
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    table->verticalHeader()->setVisible(false);
+    table->setAlternatingRowColors(true);
+    table->setStyleSheet(
+        "QTableWidget {"
+        "    alternate-background-color: #303234;"
+        "    background-color: #18191a;"
+        "}"
+    );
+
+    auto formatNanos = [](const double nanos) -> QString {
+        if (nanos < 1e3) return QString("%1 ns").arg(nanos, 0, 'f', 0);
+        if (nanos < 1e6) return QString("%1 us").arg(nanos / 1e3, 0, 'f', 1);
+        return QString("%1 ms").arg(nanos / 1e6, 0, 'f', 1);
+    };
+
+    auto fill = [this, table, formatNanos]() {
+        const Metrics::Snapshot stats = library->stats();
+        for (std::size_t i = 0; i < Metrics::OP_COUNT; ++i) {
+            const auto op = static_cast<Metrics::Op>(i);
+            const Metrics::OpStats& s = stats[op];
+            const int row = static_cast<int>(i);
+
+            table->setItem(row, 0, new QTableWidgetItem(Metrics::opName(op)));
+            table->setItem(row, 1, new QTableWidgetItem(QString::number(s.calls)));
+            table->setItem(row, 2, new QTableWidgetItem(formatNanos(s.meanNanos())));
+            table->setItem(row, 3, new QTableWidgetItem(formatNanos(static_cast<double>(s.percentileNanos(0.50)))));
+            table->setItem(row, 4, new QTableWidgetItem(formatNanos(static_cast<double>(s.percentileNanos(0.90)))));
+            table->setItem(row, 5, new QTableWidgetItem(formatNanos(static_cast<double>(s.percentileNanos(0.99)))));
+            table->setItem(row, 6, new QTableWidgetItem(formatNanos(static_cast<double>(s.maxNanos))));
+        }
+    };
+    fill();
     layout->addWidget(table);
 
+    auto* note = new QLabel("Lookups are timed one call in 64, call counts are exact.", &dialog);
+    note->setStyleSheet("color: #888888;");
+    layout->addWidget(note);
+
+    auto* buttonLayout = new QHBoxLayout();
+
+    auto* enabledBox = new QCheckBox("Collect timings", &dialog);
+    enabledBox->setChecked(Metrics::enabled());
+    connect(enabledBox, &QCheckBox::toggled, &dialog, [](const bool on) { Metrics::setEnabled(on); });
+    buttonLayout->addWidget(enabledBox);
+    buttonLayout->addStretch();
+
+    auto* refreshButton = new QPushButton("Refresh", &dialog);
+    connect(refreshButton, &QPushButton::clicked, &dialog, fill);
+    buttonLayout->addWidget(refreshButton);
+
+    auto* exportButton = new QPushButton("Export JSON", &dialog);
+    connect(exportButton, &QPushButton::clicked, &dialog, [this, &dialog]() {
+        try {
+            library->dumpStats();
+            QMessageBox::information(&dialog, "Export Complete", "Statistics written to Data/Stats.json");
+        } catch (const std::exception& e) {
+            QMessageBox::warning(&dialog, "Error", QString("Failed to export: ") + e.what());
+        }
+    });
+    buttonLayout->addWidget(exportButton);
+
     auto* closeButton = new QPushButton("Close", &dialog);
     connect(closeButton, &QPushButton::clicked, &dialog, &QDialog::accept);
-    layout->addWidget(closeButton, 0, Qt::AlignRight);
+    buttonLayout->addWidget(closeButton);
+
+    layout->addLayout(buttonLayout);
+
+    dialog.exec();
+}
+
+void MainWindow::onViewMemoryClicked() {
+    QDialog dialog(this);
+    dialog.setWindowTitle("Memory Usage");
+    dialog.resize(600, 420);
+
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+
+    QTableWidget* table = new QTableWidget(static_cast<int>(Memory::POOL_COUNT) + 1, 4, &dialog);
+    table->setHorizontalHeaderLabels({"Category", "Bytes", "Blocks", "Per Book"});
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    table->verticalHeader()->setVisible(false);
+    table->setAlternatingRowColors(true);
+    table->setStyleSheet(
+        "QTableWidget {"
+        "    alternate-background-color: #303234;"
+        "    background-color: #18191a;"
+        "}"
+    );
+    layout->addWidget(table);
+
+    auto* estimate = new QLabel(&dialog);
+    estimate->setStyleSheet("color: #888888;");
+    layout->addWidget(estimate);
+
+    auto formatBytes = [](const double bytes) -> QString {
+        if (bytes < 1024) return QString("%1 B").arg(bytes, 0, 'f', 0);
+        if (bytes < 1024 * 1024) return QString("%1 KB").arg(bytes / 1024, 0, 'f', 1);
+        return QString("%1 MB").arg(bytes / (1024 * 1024), 0, 'f', 1);
+    };
+
+    auto fill = [this, table, estimate, formatBytes]() {
+        const Memory::Snapshot usage = library->memoryUsage();
+        const double bookCount = static_cast<double>(std::max<std::size_t>(library->getBooks().size(), 1));
+
+        auto setRow = [&](const int row, const QString& name, const Memory::Usage& u) {
+            table->setItem(row, 0, new QTableWidgetItem(name));
+            table->setItem(row, 1, new QTableWidgetItem(formatBytes(static_cast<double>(u.bytes))));
+            table->setItem(row, 2, new QTableWidgetItem(QString::number(u.blocks)));
+            table->setItem(row, 3, new QTableWidgetItem(formatBytes(static_cast<double>(u.bytes) / bookCount)));
+        };
+
+        for (std::size_t i = 0; i < Memory::POOL_COUNT; ++i) {
+            setRow(static_cast<int>(i), Memory::poolName(static_cast<Memory::Pool>(i)), usage.pools[i]);
+        }
+        const Memory::Usage total = usage.total();
+        setRow(static_cast<int>(Memory::POOL_COUNT), "Total", total);
+
+        // malloc adds roughly 16 bytes to every block it hands out
+        const double perBook = (static_cast<double>(total.bytes) + 16.0 * static_cast<double>(total.blocks)) / bookCount;
+        estimate->setText(QString("About %1 per book with allocator overhead, so 100,000 books need roughly %2.")
+            .arg(formatBytes(perBook), formatBytes(perBook * 100000)));
+    };
+    fill();
+
+    auto* buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+
+    auto* refreshButton = new QPushButton("Refresh", &dialog);
+    connect(refreshButton, &QPushButton::clicked, &dialog, fill);
+    buttonLayout->addWidget(refreshButton);
+
+    auto* exportButton = new QPushButton("Export JSON", &dialog);
+    connect(exportButton, &QPushButton::clicked, &dialog, [this, &dialog]() {
+        try {
+            library->dumpMemoryUsage();
+            QMessageBox::information(&dialog, "Export Complete", "Memory usage written to Data/Memory.json");
+        } catch (const std::exception& e) {
+            QMessageBox::warning(&dialog, "Error", QString("Failed to export: ") + e.what());
+        }
+    });
+    buttonLayout->addWidget(exportButton);
+
+    auto* closeButton = new QPushButton("Close", &dialog);
+    connect(closeButton, &QPushButton::clicked, &dialog, &QDialog::accept);
+    buttonLayout->addWidget(closeButton);
+
+    layout->addLayout(buttonLayout);
 
     dialog.exec();
 }
@@ -693,7 +1349,6 @@ void MainWindow::onAddBookClicked()
                 library->addBook(new EBook(title.toStdString(), author.toStdString(), genre, fileSize));
             }
 
-            refreshBookTable();
             statusBar()->showMessage("Book added successfully", 3000);
 
         } catch (const std::exception& e) {
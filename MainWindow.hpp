@@ -3,11 +3,25 @@
 
 #include <QMainWindow>
 #include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
 #include <QLineEdit>
 #include <QComboBox>
 #include <QTextEdit>
+#include <QTimer>
+#include <QCompleter>
+#include <QStringListModel>
+#include <QProgressBar>
+#include <QGroupBox>
+#include <QAction>
+#include <QFileSystemWatcher>
 #include "Library.hpp"
+#include "BookTableModel.hpp"
+#include "SearchWorker.hpp"
+#include "CatalogLoader.hpp"
+#include "Replication/Replica.hpp"
+#include <QLabel>
+#include <memory>
 
 class MainWindow : public QMainWindow
 {
@@ -16,30 +30,78 @@ class MainWindow : public QMainWindow
 public:
     explicit MainWindow(Library* lib, QWidget *parent = nullptr);
 
+    // Shows progress in the status bar while books arrive, desk actions wait until it's done
+    void loadCatalogInBackground();
+    // Primary: once the catalog has loaded, ship every change to directory for replicas
+    void shipChangesTo(const QString& directory);
+    // Read-only replica of the primary shipping to directory, instead of loading Data/
+    void followPrimary(const QString& directory);
+
 private:
     void setupUI();
     void setupMenuBar();
     void displayPatronInfo(const Patron* patron);
+    void showFilteredBooks(BookFilterProxyModel::Filter filter);
+    void startSearch();
+    void setEditingEnabled(bool enabled);
+    bool ensureTransactions();  // Loads the log on first use, false (after a warning) if it can't
+    void watchBooksFile();  // Safe to call again, a file renamed over Books.txt drops off the watcher
 
     Library* library;
-    QTableWidget* bookTable{};
+    QTableView* bookTable{};
+    BookTableModel* bookModel{};
+    BookFilterProxyModel* bookProxy{};
     QLineEdit* patronIdEdit{};
     QLineEdit* bookTitleEdit{};
     QLineEdit* searchEdit{};
     QComboBox* searchTypeCombo{};
     QPushButton* checkoutButton{};
     QPushButton* returnButton{};
+    QPushButton* holdButton{};
+    QGroupBox* transactionGroup{};
+    QPushButton* addPatronButton{};
+    QPushButton* addBookButton{};
+    QAction* saveAction{};
     QLineEdit* patronLookupEdit{};
+    QStringListModel* patronSuggestions{};
+    QStringListModel* titleSuggestions{};
+
+    SearchWorker* searchWorker{};
+    QTimer* searchDebounce{};
+    quint64 activeSearch = 0;
+
+    CatalogLoader* loader{};
+    QProgressBar* loadProgress{};
+
+    QFileSystemWatcher* booksWatcher{};  // Books.txt edited by something else
+    QTimer* reloadDebounce{};
+
+    QString shipDirectory;
+    std::unique_ptr<Replication::Replica> replica;
+    QTimer* replicaPoll{};
+    QLabel* replicaStatus{};
 
 private slots:
     void refreshBookTable();
     void onSearchClicked();
+    void onAdvancedSearchClicked();
+    void onSearchBatch(quint64 generation, const QList<int>& bookIds);
+    void onSearchFinished(quint64 generation, int total, bool hasMore, bool closeMatches);
     void onLookupPatronClicked();
+    void onPatronLookupEdited(const QString& text);
+    void onBookTitleEdited(const QString& text);
     void onCheckoutClicked();
     void onReturnClicked();
+    void onPlaceHoldClicked();
     void onViewTransactionsClicked();
+    void onViewStatisticsClicked();
+    void onViewHistoryReportClicked();
+    void onViewPerformanceClicked();
+    void onViewMemoryClicked();
     void onAddPatronClicked();
     void onAddBookClicked();
+    void onBooksFileChanged();
+    void onReplicaPoll();
 };
 
 #endif
\ No newline at end of file
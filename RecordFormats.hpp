@@ -0,0 +1,113 @@
+#ifndef FINAL_PROJECT_RECORDFORMATS_HPP
+#define FINAL_PROJECT_RECORDFORMATS_HPP
+
+#include <optional>
+#include <string_view>
+#include "Book/Book.hpp"
+#include "Transaction/Transaction.hpp"
+#include "RecordSchema.hpp"
+
+// Line layouts of the data files. Strings are views into the line being read or the
+// record being written, so a line costs no allocations either way.
+
+// Same spellings as Book::genreToString(), plus the one the genre search used to suggest
+template<>
+struct Schema::EnumNames<Book::Genre> {
+    static constexpr std::array<std::pair<Book::Genre, std::string_view>, 6> values{{
+        {Book::Genre::Fiction, "Fiction"},
+        {Book::Genre::NonFiction, "Non-Fiction"},
+        {Book::Genre::Mystery, "Mystery"},
+        {Book::Genre::Science, "Science"},
+        {Book::Genre::Biography, "Biography"},
+        {Book::Genre::NonFiction, "NonFiction"},
+    }};
+};
+
+// Spelled without the space Book::bookStatusToString() puts in for display
+template<>
+struct Schema::EnumNames<Book::BookStatus> {
+    static constexpr std::array<std::pair<Book::BookStatus, std::string_view>, 2> values{{
+        {Book::BookStatus::Available, "Available"},
+        {Book::BookStatus::CheckedOut, "CheckedOut"},
+    }};
+};
+
+// Everything old Transactions.txt files call a checkout or return, in any case.
+// Transaction::stringToType() strips a trailing '.' before looking these up.
+template<>
+struct Schema::EnumNames<TransactionType> {
+    static constexpr bool IGNORE_CASE = true;
+    static constexpr std::array<std::pair<TransactionType, std::string_view>, 6> values{{
+        {TransactionType::Checkout, "Check Out"},
+        {TransactionType::Checkout, "Checked Out"},
+        {TransactionType::Checkout, "Checkout"},
+        {TransactionType::Checkout, "Checked_Out"},
+        {TransactionType::Return, "Return"},
+        {TransactionType::Return, "Returned"},
+    }};
+};
+
+// Books.txt
+struct BookLine {
+    Book::Genre genre = Book::Genre::Fiction;
+    std::string_view title;
+    std::string_view author;
+    std::string_view type;   // "EBook", "PrintedBook", anything else is a plain Book
+    std::string_view extra;  // File size in MB or page count, depending on type
+    // Old files may stop before here. These were only ever read back for checked out books, so a
+    // misspelt status means available and junk dates or patrons are dropped, like they always were.
+    Schema::Lenient<Book::BookStatus> status;
+    Schema::Lenient<Date> checkoutDate;
+    Schema::Lenient<Date> dueDate;
+    Schema::Lenient<int> patronId;
+    std::optional<int> id;   // Older files have no ID column
+};
+
+using BookSchema = Schema::Record<BookLine,
+    Schema::Field<"genre", &BookLine::genre>,
+    Schema::Field<"title", &BookLine::title>,
+    Schema::Field<"author", &BookLine::author>,
+    Schema::Field<"type", &BookLine::type>,
+    Schema::Field<"extra", &BookLine::extra>,
+    Schema::Field<"status", &BookLine::status>,
+    Schema::Field<"checkoutDate", &BookLine::checkoutDate>,
+    Schema::Field<"dueDate", &BookLine::dueDate>,
+    Schema::Field<"patronId", &BookLine::patronId>,
+    Schema::Field<"id", &BookLine::id>>;
+
+// Patrons.txt
+struct PatronLine {
+    int id = 0;
+    std::string_view name;
+};
+
+using PatronSchema = Schema::Record<PatronLine,
+    Schema::Field<"id", &PatronLine::id>,
+    Schema::Field<"name", &PatronLine::name>>;
+
+// Holds.txt, one line per waiting patron in queue order
+struct HoldLine {
+    int patronId = 0;
+    std::string_view title;
+};
+
+using HoldSchema = Schema::Record<HoldLine,
+    Schema::Field<"patronId", &HoldLine::patronId>,
+    Schema::Field<"title", &HoldLine::title>>;
+
+// Transactions.txt (import/export only). Books go by title so the file stays readable, and
+// the type is left as text because old files spell it half a dozen ways.
+struct TransactionLine {
+    int patronId = 0;
+    std::string_view title;
+    std::string_view type;
+    Date date = Date::fromDayNumber(0);
+};
+
+using TransactionTextSchema = Schema::Record<TransactionLine,
+    Schema::Field<"patronId", &TransactionLine::patronId>,
+    Schema::Field<"title", &TransactionLine::title>,
+    Schema::Field<"type", &TransactionLine::type>,
+    Schema::Field<"date", &TransactionLine::date>>;
+
+#endif
\ No newline at end of file
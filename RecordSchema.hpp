@@ -0,0 +1,444 @@
+#ifndef FINAL_PROJECT_RECORDSCHEMA_HPP
+#define FINAL_PROJECT_RECORDSCHEMA_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "Transaction/Date.hpp"
+
+/* Declare a record's fields once and get its text and binary routines generated from that:
+ *
+ *   using PatronSchema = Schema::Record<PatronLine,
+ *       Schema::Field<"id", &PatronLine::id>,
+ *       Schema::Field<"name", &PatronLine::name>>;
+ *
+ * Text is one '|' separated line, fields in the order they're listed. Fields missing from the
+ * end of a line parse as empty, so columns can be added at the end without breaking old files.
+ * A line ending in "\r\n" (saved on Windows) parses the same as one ending in "\n".
+ * Binary is the same fields back to back: unsigned ints as LEB128 varints, signed ones zigzagged
+ * first, strings length-prefixed, optionals behind a presence byte, dates as day numbers.
+ *
+ * Nothing here allocates. Formatting appends to a buffer the caller reuses, and string_view
+ * fields parse as views into the line (only std::string fields copy). Enums need an
+ * EnumNames specialization with their spellings, they're decoded through EnumDecoder. */
+namespace Schema {
+    template<std::size_t N>
+    struct Name {
+        char value[N]{};
+        constexpr Name(const char (&s)[N]) { std::copy_n(s, N, value); }
+        [[nodiscard]] constexpr std::string_view view() const { return {value, N - 1}; }
+    };
+
+    // template<> struct EnumNames<E> { static constexpr std::array<std::pair<E, std::string_view>, N> values{...}; };
+    // Optionally static constexpr bool IGNORE_CASE = true;
+    template<typename E>
+    struct EnumNames;
+
+    template<typename T>
+    struct MemberOf;
+
+    template<typename R, typename T>
+    struct MemberOf<T R::*> {
+        using Record = R;
+        using Type = T;
+    };
+
+    template<Name FieldName, auto Member>
+    struct Field {
+        using Record = typename MemberOf<decltype(Member)>::Record;
+        using Type = typename MemberOf<decltype(Member)>::Type;
+        static constexpr std::string_view name = FieldName.view();
+        static constexpr auto member = Member;
+    };
+
+    // Placeholder for an optional that's about to be parsed into (Date() would read the clock)
+    template<typename T>
+    T blank() {
+        if constexpr (std::is_same_v<T, Date>) return Date::fromDayNumber(0);
+        else return T{};
+    }
+
+    // A column hand-edited files get sloppy in. Anything that doesn't parse reads as empty
+    // instead of failing the whole line, the way the old stream-based parsers shrugged it off.
+    // Written the same as the std::optional<T> it wraps.
+    template<typename T>
+    struct Lenient {
+        std::optional<T> value;
+    };
+
+    // ===== Text =====
+
+    template<typename T, typename = void>
+    struct Text;
+
+    template<typename T>
+    struct Text<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+        static void format(const T value, std::string& out) {
+            char digits[24];
+            const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+            out.append(digits, end);
+        }
+        static bool parse(const std::string_view s, T& value) {
+            const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+            return ec == std::errc() && end == s.data() + s.size() && !s.empty();
+        }
+    };
+
+    template<>
+    struct Text<double> {
+        // Six decimals, same as std::to_string
+        static void format(const double value, std::string& out) {
+            char digits[64];
+            const auto end = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 6).ptr;
+            out.append(digits, end);
+        }
+        static bool parse(const std::string_view s, double& value) {
+            const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+            return ec == std::errc() && end == s.data() + s.size() && !s.empty();
+        }
+    };
+
+    template<>
+    struct Text<std::string_view> {
+        static void format(const std::string_view value, std::string& out) { out.append(value); }
+        static bool parse(const std::string_view s, std::string_view& value) { value = s; return true; }
+    };
+
+    template<>
+    struct Text<std::string> {
+        static void format(const std::string& value, std::string& out) { out.append(value); }
+        static bool parse(const std::string_view s, std::string& value) { value.assign(s); return true; }
+    };
+
+    /* Perfect hash over an enum's spellings, the seed is searched for at compile time so a lookup
+     * is one hash of the (short) string, one table load and one compare. An enum can list several
+     * spellings for the same value (formatting writes the first) and set IGNORE_CASE = true. */
+    template<typename E>
+    class EnumDecoder {
+        static constexpr auto& values = EnumNames<E>::values;
+        static constexpr std::size_t SLOTS = std::bit_ceil(values.size() * 2);
+        static constexpr std::uint8_t EMPTY = 0xFF;
+        static_assert(values.size() < EMPTY, "Too many spellings for one enum");
+
+        struct Table {
+            std::uint32_t seed = 0;
+            std::array<std::uint8_t, SLOTS> slots{};
+        };
+
+        static constexpr bool ignoreCase() {
+            if constexpr (requires { EnumNames<E>::IGNORE_CASE; }) return EnumNames<E>::IGNORE_CASE;
+            else return false;
+        }
+
+        static constexpr unsigned char fold(const char c) {
+            if (ignoreCase() && c >= 'A' && c <= 'Z') return static_cast<unsigned char>(c - 'A' + 'a');
+            return static_cast<unsigned char>(c);
+        }
+
+        // Seeded FNV-1a
+        static constexpr std::size_t hash(const std::string_view s, const std::uint32_t seed) {
+            std::uint32_t h = 2166136261u ^ seed;
+            for (const char c : s) h = (h ^ fold(c)) * 16777619u;
+            return (h ^ (h >> 15)) & (SLOTS - 1);
+        }
+
+        static constexpr bool same(const std::string_view a, const std::string_view b) {
+            if (a.size() != b.size()) return false;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                if (fold(a[i]) != fold(b[i])) return false;
+            }
+            return true;
+        }
+
+        static constexpr Table build() {
+            for (std::uint32_t seed = 0; seed < 100000; ++seed) {
+                Table table{seed, {}};
+                table.slots.fill(EMPTY);
+                bool collided = false;
+                for (std::size_t i = 0; i < values.size() && !collided; ++i) {
+                    auto& slot = table.slots[hash(values[i].second, seed)];
+                    collided = slot != EMPTY;
+                    slot = static_cast<std::uint8_t>(i);
+                }
+                if (!collided) return table;
+            }
+            throw std::logic_error("No perfect hash found, are two spellings the same?");
+        }
+
+    public:
+        static bool decode(const std::string_view s, E& value) {
+            static constexpr Table TABLE = build();
+            const std::uint8_t index = TABLE.slots[hash(s, TABLE.seed)];
+            if (index == EMPTY || !same(values[index].second, s)) return false;
+            value = values[index].first;
+            return true;
+        }
+    };
+
+    template<typename E>
+    struct Text<E, std::enable_if_t<std::is_enum_v<E>>> {
+        static void format(const E value, std::string& out) {
+            for (const auto& [e, name] : EnumNames<E>::values) {
+                if (e == value) { out.append(name); return; }
+            }
+        }
+        static bool parse(const std::string_view s, E& value) { return EnumDecoder<E>::decode(s, value); }
+    };
+
+    // dd/mm/yyyy, like Date::toString(). Reads like the old "d >> sep >> m >> sep >> y" did, any one
+    // character separates the parts, spaces around them are fine and anything after the year is ignored.
+    template<>
+    struct Text<Date> {
+        static void format(const Date& date, std::string& out) {
+            auto twoDigits = [&out](const int n) {
+                out.push_back(static_cast<char>('0' + n / 10 % 10));
+                out.push_back(static_cast<char>('0' + n % 10));
+            };
+            twoDigits(date.getDay());
+            out.push_back('/');
+            twoDigits(date.getMonth());
+            out.push_back('/');
+            Text<int>::format(date.getYear(), out);
+        }
+        static bool parse(const std::string_view s, Date& date) {
+            const char* p = s.data();
+            const char* const end = s.data() + s.size();
+            auto skipSpaces = [&p, end]() { while (p != end && (*p == ' ' || *p == '\t')) ++p; };
+
+            int parts[3];
+            for (int i = 0; i < 3; ++i) {
+                skipSpaces();
+                if (i > 0) {
+                    if (p == end) return false;
+                    ++p;  // The separator
+                    skipSpaces();
+                }
+                const auto [next, ec] = std::from_chars(p, end, parts[i]);
+                if (ec != std::errc()) return false;
+                p = next;
+            }
+
+            const auto [day, month, year] = parts;
+            if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+            date = Date(day, month, year);
+            return true;
+        }
+    };
+
+    // "null" when empty, an empty column reads as empty too
+    template<typename T>
+    struct Text<std::optional<T>> {
+        static void format(const std::optional<T>& value, std::string& out) {
+            if (value) Text<T>::format(*value, out);
+            else out.append("null");
+        }
+        static bool parse(const std::string_view s, std::optional<T>& value) {
+            if (s.empty() || s == "null") {
+                value.reset();
+                return true;
+            }
+            if (!value) value.emplace(blank<T>());
+            return Text<T>::parse(s, *value);
+        }
+    };
+
+    template<typename T>
+    struct Text<Lenient<T>> {
+        static void format(const Lenient<T>& column, std::string& out) { Text<std::optional<T>>::format(column.value, out); }
+        static bool parse(const std::string_view s, Lenient<T>& column) {
+            if (!Text<std::optional<T>>::parse(s, column.value)) column.value.reset();
+            return true;
+        }
+    };
+
+    // ===== Binary =====
+
+    inline void appendVarint(std::string& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    inline std::uint64_t readVarint(std::string_view& in) {
+        std::uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (in.empty()) throw std::runtime_error("Truncated binary record.");
+            const auto byte = static_cast<unsigned char>(in.front());
+            in.remove_prefix(1);
+            result |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return result;
+        }
+        throw std::runtime_error("Malformed varint in binary record.");
+    }
+
+    inline std::string_view readBytes(std::string_view& in, const std::size_t n) {
+        if (in.size() < n) throw std::runtime_error("Truncated binary record.");
+        const std::string_view bytes = in.substr(0, n);
+        in.remove_prefix(n);
+        return bytes;
+    }
+
+    template<typename T, typename = void>
+    struct Binary;
+
+    template<typename T>
+    struct Binary<T, std::enable_if_t<std::is_unsigned_v<T> && !std::is_same_v<T, bool>>> {
+        static void encode(const T value, std::string& out) { appendVarint(out, value); }
+        static void decode(std::string_view& in, T& value) {
+            const std::uint64_t raw = readVarint(in);
+            if (raw > std::numeric_limits<T>::max()) throw std::runtime_error("Binary record value out of range.");
+            value = static_cast<T>(raw);
+        }
+    };
+
+    template<typename T>
+    struct Binary<T, std::enable_if_t<std::is_signed_v<T> && std::is_integral_v<T>>> {
+        using U = std::make_unsigned_t<T>;
+        static void encode(const T value, std::string& out) {
+            appendVarint(out, (static_cast<U>(value) << 1) ^ static_cast<U>(value >> (sizeof(T) * 8 - 1)));
+        }
+        static void decode(std::string_view& in, T& value) {
+            U raw;
+            Binary<U>::decode(in, raw);
+            value = static_cast<T>((raw >> 1) ^ (~(raw & 1) + 1));
+        }
+    };
+
+    template<typename E>
+    struct Binary<E, std::enable_if_t<std::is_enum_v<E>>> {
+        using U = std::make_unsigned_t<std::underlying_type_t<E>>;
+        static void encode(const E value, std::string& out) { Binary<U>::encode(static_cast<U>(value), out); }
+        static void decode(std::string_view& in, E& value) {
+            U raw;
+            Binary<U>::decode(in, raw);
+            value = static_cast<E>(raw);
+        }
+    };
+
+    // Little-endian IEEE bits, 8 bytes
+    template<>
+    struct Binary<double> {
+        static void encode(const double value, std::string& out) {
+            const auto bits = std::bit_cast<std::uint64_t>(value);
+            for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>(bits >> (8 * i)));
+        }
+        static void decode(std::string_view& in, double& value) {
+            const std::string_view bytes = readBytes(in, 8);
+            std::uint64_t bits = 0;
+            for (int i = 0; i < 8; ++i) bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+            value = std::bit_cast<double>(bits);
+        }
+    };
+
+    template<>
+    struct Binary<std::string_view> {
+        static void encode(const std::string_view value, std::string& out) {
+            appendVarint(out, value.size());
+            out.append(value);
+        }
+        static void decode(std::string_view& in, std::string_view& value) {
+            std::size_t n;
+            Binary<std::size_t>::decode(in, n);
+            value = readBytes(in, n);
+        }
+    };
+
+    template<>
+    struct Binary<std::string> {
+        static void encode(const std::string& value, std::string& out) { Binary<std::string_view>::encode(value, out); }
+        static void decode(std::string_view& in, std::string& value) {
+            std::string_view view;
+            Binary<std::string_view>::decode(in, view);
+            value.assign(view);
+        }
+    };
+
+    template<>
+    struct Binary<Date> {
+        static void encode(const Date& date, std::string& out) { Binary<int>::encode(date.toDayNumber(), out); }
+        static void decode(std::string_view& in, Date& date) {
+            int dayNumber;
+            Binary<int>::decode(in, dayNumber);
+            date = Date::fromDayNumber(dayNumber);
+        }
+    };
+
+    template<typename T>
+    struct Binary<std::optional<T>> {
+        static void encode(const std::optional<T>& value, std::string& out) {
+            out.push_back(value ? 1 : 0);
+            if (value) Binary<T>::encode(*value, out);
+        }
+        static void decode(std::string_view& in, std::optional<T>& value) {
+            if (readBytes(in, 1)[0] == 0) {
+                value.reset();
+                return;
+            }
+            if (!value) value.emplace(blank<T>());
+            Binary<T>::decode(in, *value);
+        }
+    };
+
+    template<typename T>
+    struct Binary<Lenient<T>> {
+        static void encode(const Lenient<T>& column, std::string& out) { Binary<std::optional<T>>::encode(column.value, out); }
+        static void decode(std::string_view& in, Lenient<T>& column) { Binary<std::optional<T>>::decode(in, column.value); }
+    };
+
+    // ===== Records =====
+
+    template<typename R, typename... Fields>
+    struct Record {
+        static_assert((std::is_same_v<typename Fields::Record, R> && ...), "Every field must belong to the record");
+
+        static constexpr std::size_t FIELD_COUNT = sizeof...(Fields);
+        static constexpr std::array<std::string_view, FIELD_COUNT> names{Fields::name...};
+
+        // Appends one line, no newline
+        static void formatText(const R& record, std::string& out) {
+            bool first = true;
+            ((first ? void(first = false) : out.push_back('|'), Text<typename Fields::Type>::format(record.*Fields::member, out)), ...);
+        }
+
+        // Throws std::invalid_argument naming the field that didn't parse
+        static void parseText(std::string_view line, R& record) {
+            if (line.ends_with('\r')) line.remove_suffix(1);
+            (parseField<Fields>(line, record), ...);
+        }
+
+        static void encodeBinary(const R& record, std::string& out) {
+            (Binary<typename Fields::Type>::encode(record.*Fields::member, out), ...);
+        }
+
+        // Consumes one record from the front of in, throws std::runtime_error if it's cut short
+        static void decodeBinary(std::string_view& in, R& record) {
+            (Binary<typename Fields::Type>::decode(in, record.*Fields::member), ...);
+        }
+
+    private:
+        template<typename F>
+        static void parseField(std::string_view& rest, R& record) {
+            const auto bar = rest.find('|');
+            const std::string_view value = rest.substr(0, bar);
+            rest = bar == std::string_view::npos ? std::string_view{} : rest.substr(bar + 1);
+
+            if (!Text<typename F::Type>::parse(value, record.*F::member)) {
+                throw std::invalid_argument("Invalid " + std::string(F::name) + ": '" + std::string(value) + "'");
+            }
+        }
+    };
+}
+
+#endif
\ No newline at end of file
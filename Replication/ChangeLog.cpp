@@ -0,0 +1,133 @@
+#include "ChangeLog.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    constexpr char MAGIC[4] = {'L', 'C', 'H', 'G'};
+    constexpr char VERSION = 1;
+
+    // Epoch and header length, nullopt if the header isn't (all) there
+    std::optional<std::pair<std::uint64_t, std::size_t>> readHeader(std::istream& in) {
+        char bytes[sizeof(MAGIC) + 1 + 10];
+        in.read(bytes, sizeof(bytes));
+        std::string_view header(bytes, static_cast<std::size_t>(in.gcount()));
+        in.clear();
+
+        if (header.size() < sizeof(MAGIC) + 1 || header.substr(0, sizeof(MAGIC)) != std::string_view(MAGIC, sizeof(MAGIC))) return std::nullopt;
+        if (header[sizeof(MAGIC)] != VERSION) throw std::runtime_error("Unsupported change log version.");
+
+        std::string_view rest = header.substr(sizeof(MAGIC) + 1);
+        try {
+            const std::uint64_t epoch = Schema::readVarint(rest);
+            return std::pair(epoch, header.size() - rest.size());
+        } catch (const std::runtime_error&) {
+            return std::nullopt;
+        }
+    }
+
+    // The clock, bumped past the last one handed out so a re-base within the same millisecond still looks new
+    std::uint64_t nextEpoch() {
+        static std::uint64_t last = 0;
+        last = std::max(static_cast<std::uint64_t>(Replication::nowMillis()), last + 1);
+        return last;
+    }
+}
+
+std::string Replication::logPath(const std::string& directory) {
+    return directory + "/Changes.log";
+}
+
+std::int64_t Replication::nowMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+Replication::ChangeLogWriter::ChangeLogWriter(const std::string& directory)
+    : epochId(nextEpoch()) {
+    const std::string path = logPath(directory);
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) throw std::runtime_error("Failed to open file for writing: " + path);
+
+    std::string header(MAGIC, sizeof(MAGIC));
+    header.push_back(VERSION);
+    Schema::appendVarint(header, epochId);
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.flush();
+
+    std::cout << "Shipping changes to " << path << " (epoch " << epochId << ")" << std::endl;
+}
+
+void Replication::ChangeLogWriter::append(Change change) {
+    change.sequence = nextSequence++;
+    change.writtenAt = nowMillis();
+
+    record.clear();
+    ChangeSchema::encodeBinary(change, record);
+    frame.clear();
+    Schema::appendVarint(frame, record.size());
+    frame.append(record);
+
+    file.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    file.flush();
+    if (!file) throw std::runtime_error("Failed to write to the change log.");
+}
+
+Replication::ChangeLogReader::ChangeLogReader(const std::string& directory)
+    : path(logPath(directory)) {}
+
+std::optional<std::uint64_t> Replication::ChangeLogReader::currentEpoch() const {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return std::nullopt;
+    const auto header = readHeader(file);
+    return header ? std::optional(header->first) : std::nullopt;
+}
+
+void Replication::ChangeLogReader::reset(const std::uint64_t epoch) {
+    epochId = epoch;
+    offset = 0;
+    pending.clear();
+}
+
+bool Replication::ChangeLogReader::poll(const std::function<void(const Change&)>& apply) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    const auto header = readHeader(file);
+    if (!header || header->first != epochId) return false;
+    if (offset == 0) offset = header->second;
+
+    file.seekg(static_cast<std::streamoff>(offset));
+    const std::string appended((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    offset += appended.size();
+    pending.append(appended);
+
+    // The last record may still be half written, it stays in pending for next time. A record
+    // counts as read before it's decoded, so one that throws is never handed out twice.
+    std::string_view rest(pending);
+    Change change;
+    try {
+        while (!rest.empty()) {
+            std::string_view body = rest;
+            std::uint64_t length;
+            try {
+                length = Schema::readVarint(body);
+            } catch (const std::runtime_error&) {
+                break;
+            }
+            if (body.size() < length) break;
+
+            rest = body.substr(length);
+            body = body.substr(0, length);
+            ChangeSchema::decodeBinary(body, change);
+            apply(change);
+        }
+    } catch (...) {
+        pending.erase(0, pending.size() - rest.size());
+        throw;
+    }
+    pending.erase(0, pending.size() - rest.size());
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef FINAL_PROJECT_CHANGELOG_HPP
+#define FINAL_PROJECT_CHANGELOG_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "RecordSchema.hpp"
+
+/* Log shipping from a primary desk to read-only replicas through a shared directory:
+ *
+ *   <dir>/Base/        the primary's catalog when it started shipping (the usual data files)
+ *   <dir>/Changes.log  every change it's made since, appended and flushed one at a time
+ *
+ * Changes.log is "LCHG" + version byte + varint epoch, then records as varint length +
+ * ChangeSchema. The epoch is new every time the primary (re)starts shipping. It deletes the log
+ * before rewriting Base/ and only writes the new header once Base/ is complete, so a replica that
+ * sees the same epoch before and after reading Base/ knows it read a whole one. */
+namespace Replication {
+    enum class ChangeType : std::uint8_t {
+        Checkout,   // bookId lent to patronId
+        Return,     // bookId back from patronId, the hand-off to a waiting patron follows as its own changes
+        AddBook,    // text is the Books.txt line
+        AddPatron,  // text is the name
+        PlaceHold,  // bookId is the title ID
+        ServeHold   // Front of bookId's (a title ID) queue popped
+    };
+
+    struct Change {
+        std::uint64_t sequence = 0;
+        std::int64_t writtenAt = 0;  // Primary's clock, ms since the epoch, for measuring lag
+        ChangeType type = ChangeType::Checkout;
+        int patronId = 0;
+        int bookId = 0;
+        int day = 0;  // Date::toDayNumber() of the checkout/return
+        std::string_view text{};
+    };
+
+    using ChangeSchema = Schema::Record<Change,
+        Schema::Field<"sequence", &Change::sequence>,
+        Schema::Field<"writtenAt", &Change::writtenAt>,
+        Schema::Field<"type", &Change::type>,
+        Schema::Field<"patronId", &Change::patronId>,
+        Schema::Field<"bookId", &Change::bookId>,
+        Schema::Field<"day", &Change::day>,
+        Schema::Field<"text", &Change::text>>;
+
+    [[nodiscard]] std::string logPath(const std::string& directory);
+    [[nodiscard]] std::int64_t nowMillis();
+
+    class ChangeLogWriter {
+    private:
+        std::ofstream file;
+        std::uint64_t epochId;
+        std::uint64_t nextSequence = 1;
+        std::string record;  // Reused for every change
+        std::string frame;
+
+    public:
+        // Starts a new epoch, replaces whatever log was in directory
+        explicit ChangeLogWriter(const std::string& directory);
+
+        // Fills in sequence and writtenAt, the change is on disk when this returns
+        void append(Change change);
+
+        [[nodiscard]] std::uint64_t epoch() const { return epochId; }
+        [[nodiscard]] std::uint64_t lastSequence() const { return nextSequence - 1; }
+    };
+
+    class ChangeLogReader {
+    private:
+        std::string path;
+        std::uint64_t epochId = 0;
+        std::uint64_t offset = 0;  // File position read up to
+        std::string pending;       // A record the primary was partway through writing
+
+    public:
+        explicit ChangeLogReader(const std::string& directory);
+
+        // Epoch of the log on disk, nullopt while there isn't one (the primary is writing Base/)
+        [[nodiscard]] std::optional<std::uint64_t> currentEpoch() const;
+
+        // Read the given epoch's log from the beginning on the next poll
+        void reset(std::uint64_t epoch);
+
+        // Hands every complete change written since the last poll to apply, in order. Returns
+        // false without applying anything if the log on disk isn't our epoch anymore. Throws on a
+        // record that won't decode (or whatever apply throws), with that record already consumed.
+        bool poll(const std::function<void(const Change&)>& apply);
+
+        [[nodiscard]] std::uint64_t epoch() const { return epochId; }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "Replica.hpp"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+Replication::Replica::Replica(Library& library, std::string directory)
+    : library(library)
+    , directory(std::move(directory))
+    , reader(this->directory) {
+    library.setReadOnly(true);
+}
+
+bool Replication::Replica::bootstrap() {
+    const auto epoch = reader.currentEpoch();
+    if (!epoch) return false;
+
+    const std::string base = directory + "/Base";
+    try {
+        library.loadPatrons(base + "/Patrons.txt");
+        library.loadBooks(base + "/Books.txt");
+        library.loadHolds(base + "/Holds.txt");
+        library.loadTransactions(base + "/Transactions.bin");
+    } catch (const std::exception& e) {
+        std::cerr << "Couldn't load the primary's base copy: " << e.what() << std::endl;
+        return false;
+    }
+
+    // The primary started over while we were reading, try again next time
+    if (reader.currentEpoch() != epoch) return false;
+
+    reader.reset(*epoch);
+    brokenEpoch.reset();
+    applied = 0;
+    lastLag = maxLag = 0;
+    std::cout << "Following " << directory << " (epoch " << *epoch << ")" << std::endl;
+    return true;
+}
+
+std::size_t Replication::Replica::poll() {
+    if (!ready) {
+        if (brokenEpoch && reader.currentEpoch() == brokenEpoch) return 0;
+        ready = bootstrap();
+        if (!ready) return 0;
+    }
+
+    std::size_t count = 0;
+    const std::int64_t now = nowMillis();
+    try {
+        ready = reader.poll([&](const Change& change) {
+            if (change.sequence <= applied) return;
+            if (change.sequence != applied + 1) {
+                std::cerr << "Change log skipped from " << applied << " to " << change.sequence << std::endl;
+            }
+
+            try {
+                library.applyChange(change);
+            } catch (const std::exception& e) {
+                std::cerr << "Couldn't apply change " << change.sequence << ": " << e.what() << std::endl;
+            }
+
+            applied = change.sequence;
+            lastLag = std::max<std::int64_t>(now - change.writtenAt, 0);
+            maxLag = std::max(maxLag, lastLag);
+            count++;
+        });
+    } catch (const std::exception& e) {
+        // Can't tell what the broken record would have changed, so start over from the next Base/
+        std::cerr << "Unreadable change log record after change " << applied
+                  << ", waiting for the primary to re-base: " << e.what() << std::endl;
+        brokenEpoch = reader.epoch();
+        ready = false;
+    }
+    return count;
+}
\ No newline at end of file
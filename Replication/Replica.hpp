@@ -0,0 +1,45 @@
+#ifndef FINAL_PROJECT_REPLICA_HPP
+#define FINAL_PROJECT_REPLICA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "ChangeLog.hpp"
+#include "Library.hpp"
+
+namespace Replication {
+    /* Keeps a read-only Library in step with a primary shipping to directory. Nothing runs on
+     * its own: call poll() every so often (the window does it on a timer), lag is bounded by
+     * that interval plus however long the batch takes to apply. */
+    class Replica {
+    private:
+        Library& library;
+        std::string directory;
+        ChangeLogReader reader;
+        bool ready = false;
+        std::uint64_t applied = 0;  // Sequence of the last change applied
+        std::int64_t lastLag = 0;   // ms between the primary writing a change and us applying it
+        std::int64_t maxLag = 0;
+        std::optional<std::uint64_t> brokenEpoch;  // Its log has a record we can't read, wait for the next one
+
+        bool bootstrap();
+
+    public:
+        // Marks the library read-only
+        Replica(Library& library, std::string directory);
+
+        // Applies everything logged since the last call, returns how many changes that was.
+        // The first call (and the first after the primary restarts) loads Base/ first; until the
+        // primary is shipping it does nothing and isReady() stays false. After a record it can't read
+        // it stops following until the primary re-bases, reloading the same log would just hit it again.
+        std::size_t poll();
+
+        [[nodiscard]] bool isReady() const { return ready; }
+        [[nodiscard]] std::uint64_t appliedSequence() const { return applied; }
+        [[nodiscard]] std::int64_t lastLagMillis() const { return lastLag; }
+        [[nodiscard]] std::int64_t maxLagMillis() const { return maxLag; }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "SearchWorker.hpp"
+#include <QMetaObject>
+#include "Stats/Trace.hpp"
+
+SearchWorker::SearchWorker(QObject* parent)
+    : QObject(parent)
+    , generation(std::make_shared<std::atomic<quint64>>(0)) {
+    pool.setMaxThreadCount(1);  // Stale queued searches bail out immediately, one thread is plenty
+}
+
+SearchWorker::~SearchWorker() {
+    cancel();
+    pool.waitForDone();
+}
+
+void SearchWorker::cancel() {
+    generation->fetch_add(1);
+}
+
+quint64 SearchWorker::start(std::shared_ptr<const CatalogSnapshot> snapshot, const Field field, const std::string& term) {
+    current = std::move(snapshot);
+    currentTerm = term;
+    nextPage.reset();
+
+    if (field != Field::Genre) {
+        currentField = field == Field::Title ? SearchField::Title : SearchField::Author;
+        return startPage(std::nullopt);
+    }
+
+    try {
+        return startGenreScan(Book::stringToGenre(term));
+    } catch (...) {
+        // Half-typed genre, nothing can match
+        const quint64 myGeneration = generation->fetch_add(1) + 1;
+        QMetaObject::invokeMethod(this, [this, myGeneration]() { emit finished(myGeneration, 0, false, false); }, Qt::QueuedConnection);
+        return myGeneration;
+    }
+}
+
+quint64 SearchWorker::fetchMore() {
+    if (!nextPage) return 0;
+
+    const auto after = nextPage;
+    nextPage.reset();  // Until this page lands, so scrolling can't ask for it twice
+    return startPage(after);
+}
+
+quint64 SearchWorker::startPage(std::optional<SearchCursor> after) {
+    const quint64 myGeneration = generation->fetch_add(1) + 1;
+
+    pool.start([this, snapshot = current, field = currentField, term = currentTerm, after, gen = generation, myGeneration]() {
+        Trace::Span span("searchPage", "search", term);
+        const auto cancelled = [&gen, myGeneration]() { return gen->load(std::memory_order_relaxed) != myGeneration; };
+        const SearchPage page = rankedSearch(*snapshot, field, term, PAGE_SIZE, after, cancelled);
+        if (gen->load() != myGeneration) return;
+
+        // Nothing matched exactly, so try again allowing for typos
+        std::vector<int> closeMatches;
+        if (!after && page.totalMatches == 0) {
+            Trace::Span fuzzySpan("fuzzySearch", "search", term);
+            closeMatches = fuzzySearch(*snapshot, field, term, FUZZY_LIMIT, cancelled);
+            if (gen->load() != myGeneration) return;
+        }
+        const bool fuzzy = !closeMatches.empty();
+        const auto& found = fuzzy ? closeMatches : page.bookIds;
+        const int total = fuzzy ? static_cast<int>(closeMatches.size()) : static_cast<int>(page.totalMatches);
+
+        QList<int> ids(found.begin(), found.end());
+        QMetaObject::invokeMethod(this, [this, myGeneration, ids = std::move(ids), page, total, fuzzy]() {
+            if (generation->load() != myGeneration) return;
+            nextPage = page.next;
+            emit batchReady(myGeneration, ids);
+            emit finished(myGeneration, total, page.next.has_value(), fuzzy);
+        }, Qt::QueuedConnection);
+    });
+
+    return myGeneration;
+}
+
+quint64 SearchWorker::startGenreScan(const Book::Genre genre) {
+    const quint64 myGeneration = generation->fetch_add(1) + 1;
+
+    pool.start([this, snapshot = current, genre, gen = generation, myGeneration]() {
+        Trace::Span span("genreScan", "search");
+        QList<int> batch;
+        batch.reserve(BATCH_SIZE);
+        int total = 0;
+        std::size_t scanned = 0;
+
+        auto flush = [&]() {
+            if (batch.isEmpty()) return;
+            QMetaObject::invokeMethod(this, [this, myGeneration, ids = std::move(batch)]() {
+                emit batchReady(myGeneration, ids);
+            }, Qt::QueuedConnection);
+            batch = QList<int>();
+            batch.reserve(BATCH_SIZE);
+        };
+
+        for (const auto& record : snapshot->books) {
+            // Checking every row would cost more than the comparison itself
+            if ((++scanned & 1023) == 0 && gen->load(std::memory_order_relaxed) != myGeneration) return;
+            if (record.genre != genre) continue;
+
+            batch.append(record.id);
+            total++;
+            if (batch.size() >= BATCH_SIZE) flush();
+        }
+
+        if (gen->load() != myGeneration) return;
+        flush();
+        QMetaObject::invokeMethod(this, [this, myGeneration, total]() { emit finished(myGeneration, total, false, false); }, Qt::QueuedConnection);
+    });
+
+    return myGeneration;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef SEARCHWORKER_H
+#define SEARCHWORKER_H
+
+#include <QObject>
+#include <QList>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include "CatalogSnapshot.hpp"
+#include "Index/RankedSearch.hpp"
+
+// Runs catalog searches off the GUI thread. Starting a new search cancels the
+// previous one. Title and author searches come back ranked a page at a time
+// (fetchMore continues from the last page on the same snapshot); genre matches
+// are streamed back in batches as they're found. A title or author search with
+// no hits falls back to close (typo-tolerant) matches on the same thread.
+class SearchWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Field { Title, Author, Genre };
+
+    explicit SearchWorker(QObject* parent = nullptr);
+    ~SearchWorker() override;
+
+    quint64 start(std::shared_ptr<const CatalogSnapshot> snapshot, Field field, const std::string& term);
+    quint64 fetchMore();  // 0 if the current search has no more pages
+    void cancel();
+
+    [[nodiscard]] bool hasMore() const { return nextPage.has_value(); }
+
+signals:
+    void batchReady(quint64 generation, const QList<int>& bookIds);
+    void finished(quint64 generation, int total, bool hasMore, bool closeMatches);
+
+private:
+    static constexpr int BATCH_SIZE = 256;
+    static constexpr std::size_t PAGE_SIZE = 200;
+    static constexpr std::size_t FUZZY_LIMIT = 50;
+
+    QThreadPool pool;
+    std::shared_ptr<std::atomic<quint64>> generation;  // Shared with running tasks so they can see they're stale
+
+    // The search being paged through, only touched on the GUI thread
+    std::shared_ptr<const CatalogSnapshot> current;
+    SearchField currentField = SearchField::Title;
+    std::string currentTerm;
+    std::optional<SearchCursor> nextPage;
+
+    quint64 startPage(std::optional<SearchCursor> after);
+    quint64 startGenreScan(Book::Genre genre);
+};
+
+#endif
\ No newline at end of file
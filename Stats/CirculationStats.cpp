@@ -0,0 +1,102 @@
+#include "CirculationStats.hpp"
+#include <algorithm>
+
+void CirculationStats::closeLoan(OpenLoan& loan) {
+    loan.startDay = NO_LOAN;
+    openLoans--;
+
+    const auto it = loansByPatron.find(loan.patronId);
+    if (it != loansByPatron.end() && it->second > 0 && --it->second == 0) patronsWithLoans--;
+}
+
+void CirculationStats::bumpTop(const int titleId, const std::uint32_t checkouts) {
+    auto it = std::ranges::find(top, titleId, &BorrowCount::titleId);
+
+    if (it != top.end()) {
+        it->checkouts = checkouts;
+    } else if (top.size() < TOP_N) {
+        top.push_back({titleId, checkouts});
+        it = top.end() - 1;
+    } else if (checkouts > top.back().checkouts) {
+        top.back() = {titleId, checkouts};
+        it = top.end() - 1;
+    } else {
+        return;
+    }
+
+    // Counts only go up by one, so the entry only ever moves towards the front
+    while (it != top.begin() && (it - 1)->checkouts < it->checkouts) {
+        std::iter_swap(it, it - 1);
+        --it;
+    }
+}
+
+void CirculationStats::recordCheckout(const Transaction& t, const int titleId, const std::optional<Book::Genre> genre) {
+    const int bookId = t.getBookID();
+    if (bookId < 0 || titleId < 0) return;
+    if (static_cast<std::size_t>(titleId) >= checkoutsByTitle.size()) checkoutsByTitle.resize(titleId + 1, 0);
+    if (static_cast<std::size_t>(bookId) >= loansByBook.size()) loansByBook.resize(bookId + 1);
+
+    bumpTop(titleId, ++checkoutsByTitle[titleId]);
+    if (genre) checkoutsByDay[t.getDayNumber()][static_cast<std::size_t>(*genre)]++;
+
+    // A checkout over an open loan means the log missed a return, drop the old loan
+    OpenLoan& loan = loansByBook[bookId];
+    if (loan.startDay != NO_LOAN) closeLoan(loan);
+
+    loan = {t.getDayNumber(), t.getPatronID()};
+    openLoans++;
+    if (loansByPatron[t.getPatronID()]++ == 0) patronsWithLoans++;
+}
+
+void CirculationStats::recordReturn(const Transaction& t) {
+    const int bookId = t.getBookID();
+    if (bookId < 0 || static_cast<std::size_t>(bookId) >= loansByBook.size()) return;
+
+    // Returns for loans from before the log started have nothing to match
+    OpenLoan& loan = loansByBook[bookId];
+    if (loan.startDay == NO_LOAN) return;
+
+    totalLoanDays += static_cast<std::uint64_t>(std::max(0, t.getDayNumber() - loan.startDay));
+    completedLoans++;
+    closeLoan(loan);
+}
+
+void CirculationStats::clear() {
+    checkoutsByTitle.clear();
+    loansByBook.clear();
+    top.clear();
+    checkoutsByDay.clear();
+    loansByPatron.clear();
+    totalLoanDays = 0;
+    completedLoans = 0;
+    openLoans = 0;
+    patronsWithLoans = 0;
+}
+
+void CirculationStats::rebuild(const TransactionList& log, const TitleLookup& titleOf, const GenreLookup& genreOf) {
+    clear();
+    for (const auto& t : log) {
+        if (t.getType() == TransactionType::Checkout) recordCheckout(t, titleOf(t.getBookID()), genreOf(t.getBookID()));
+        else recordReturn(t);
+    }
+}
+
+std::uint32_t CirculationStats::timesBorrowed(const int titleId) const {
+    if (titleId < 0 || static_cast<std::size_t>(titleId) >= checkoutsByTitle.size()) return 0;
+    return checkoutsByTitle[titleId];
+}
+
+std::uint32_t CirculationStats::checkoutsOn(const int dayNumber, const Book::Genre genre) const {
+    const auto it = checkoutsByDay.find(dayNumber);
+    return it != checkoutsByDay.end() ? it->second[static_cast<std::size_t>(genre)] : 0;
+}
+
+int CirculationStats::activeLoans(const int patronId) const {
+    const auto it = loansByPatron.find(patronId);
+    return it != loansByPatron.end() ? it->second : 0;
+}
+
+double CirculationStats::averageLoanDays() const {
+    return completedLoans ? static_cast<double>(totalLoanDays) / static_cast<double>(completedLoans) : 0.0;
+}
\ No newline at end of file
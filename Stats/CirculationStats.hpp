@@ -0,0 +1,76 @@
+#ifndef FINAL_PROJECT_CIRCULATIONSTATS_HPP
+#define FINAL_PROJECT_CIRCULATIONSTATS_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include "Book/Book.hpp"
+#include "Transaction/Transaction.hpp"
+#include "Transaction/TransactionLog.hpp"
+#include "Stats/Memory.hpp"
+
+struct BorrowCount {
+    int titleId;
+    std::uint32_t checkouts;
+};
+
+/* Dashboard numbers, updated on every checkout and return so nothing has to replay the
+ * log to answer them. rebuild() replays it once when the log is loaded.
+ * Borrowing counts are per title (Library::titleIdOf, the ID of its first copy) so copies of a
+ * popular title add up instead of splitting it; open loans are per copy. IDs are dense, so the
+ * counts are exact rather than a sketch, and since they only ever go up the top-N list can be
+ * kept exact by bubbling the changed entry. */
+class CirculationStats {
+public:
+    static constexpr std::size_t GENRE_COUNT = 5;
+    static constexpr std::size_t TOP_N = 10;
+
+    using TitleLookup = std::function<int(int bookId)>;
+    using GenreLookup = std::function<std::optional<Book::Genre>(int bookId)>;
+
+private:
+    static constexpr int NO_LOAN = -1;
+
+    struct OpenLoan {
+        int startDay = NO_LOAN;
+        int patronId = 0;
+    };
+
+    static constexpr auto POOL = Memory::Pool::Statistics;
+
+    Memory::Vector<std::uint32_t, POOL> checkoutsByTitle;  // Title ID -> checkouts ever, all copies
+    Memory::Vector<OpenLoan, POOL> loansByBook;            // Book ID -> its open loan, if any
+    Memory::Vector<BorrowCount, POOL> top;                // Most borrowed first
+    Memory::HashMap<int, std::array<std::uint32_t, GENRE_COUNT>, POOL> checkoutsByDay;  // Day number -> per genre
+    Memory::HashMap<int, int, POOL> loansByPatron;  // Entries stay at 0 instead of being erased, saves reallocating
+
+    std::uint64_t totalLoanDays = 0;
+    std::uint64_t completedLoans = 0;
+    int openLoans = 0;
+    int patronsWithLoans = 0;
+
+    void closeLoan(OpenLoan& loan);
+    void bumpTop(int titleId, std::uint32_t checkouts);
+
+public:
+    CirculationStats() { top.reserve(TOP_N); }
+
+    // genre is empty for books no longer in the catalog, they still count everywhere else
+    void recordCheckout(const Transaction& t, int titleId, std::optional<Book::Genre> genre);
+    void recordReturn(const Transaction& t);
+
+    void clear();
+    void rebuild(const TransactionList& log, const TitleLookup& titleOf, const GenreLookup& genreOf);
+
+    [[nodiscard]] const Memory::Vector<BorrowCount, POOL>& mostBorrowed() const { return top; }
+    [[nodiscard]] std::uint32_t timesBorrowed(int titleId) const;
+    [[nodiscard]] std::uint32_t checkoutsOn(int dayNumber, Book::Genre genre) const;
+    [[nodiscard]] int activeLoans(int patronId) const;
+    [[nodiscard]] int activeLoans() const { return openLoans; }
+    [[nodiscard]] int patronsWithActiveLoans() const { return patronsWithLoans; }
+    [[nodiscard]] std::uint64_t loansCompleted() const { return completedLoans; }
+    [[nodiscard]] double averageLoanDays() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "CoBorrowIndex.hpp"
+#include <algorithm>
+#include <span>
+
+void CoBorrowIndex::bump(const int from, const int to) {
+    const auto index = static_cast<std::size_t>(from);
+    if (index >= rows.size()) rows.resize(index + 1);
+
+    auto& row = rows[index];
+    const auto it = std::ranges::find(row, to, &Pair::titleId);
+    if (it != row.end()) {
+        it->count++;
+        return;
+    }
+
+    if (row.capacity() == 0) row.reserve(MAX_ROW);
+    if (row.size() == MAX_ROW) {
+        // Full: make room by dropping one lowest count. Pairs only ever go on the end, so the first
+        // of those is the oldest and a long-tail row turns over in order rather than all at once.
+        row.erase(std::ranges::min_element(row, {}, &Pair::count));
+    }
+    row.push_back({to, 1});
+}
+
+void CoBorrowIndex::recordCheckout(const int patronId, const int titleId) {
+    if (titleId < 0) return;
+
+    auto& history = histories[patronId];
+    if (std::ranges::find(history, titleId) != history.end()) return;  // Borrowing it again says nothing new
+
+    for (const int other : history) {
+        bump(titleId, other);
+        bump(other, titleId);
+    }
+
+    if (history.capacity() == 0) history.reserve(MAX_HISTORY);
+    if (history.size() == MAX_HISTORY) history.erase(history.begin());
+    history.push_back(titleId);
+}
+
+void CoBorrowIndex::clear() {
+    rows.clear();
+    histories.clear();
+}
+
+std::vector<int> CoBorrowIndex::topOf(std::vector<Pair> candidates, const std::size_t k) {
+    const auto n = std::min(k, candidates.size());
+    std::ranges::partial_sort(candidates, candidates.begin() + static_cast<std::ptrdiff_t>(n),
+        [](const Pair& a, const Pair& b) { return a.count != b.count ? a.count > b.count : a.titleId < b.titleId; });
+
+    std::vector<int> result;
+    result.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) result.push_back(candidates[i].titleId);
+    return result;
+}
+
+std::vector<int> CoBorrowIndex::similar(const int titleId, const std::size_t k) const {
+    if (titleId < 0 || static_cast<std::size_t>(titleId) >= rows.size()) return {};
+    return topOf({rows[titleId].begin(), rows[titleId].end()}, k);
+}
+
+std::vector<int> CoBorrowIndex::forPatron(const int patronId, const std::size_t k) const {
+    const auto it = histories.find(patronId);
+    if (it == histories.end()) return {};
+    const auto& history = it->second;
+
+    // Only the most recent titles, they say more about what the patron wants now
+    // and keep this to a few hundred entries to merge
+    std::unordered_map<int, std::uint32_t> scores;
+    const auto recent = std::min(history.size(), RECENT_HISTORY);
+    for (const int titleId : std::span(history).last(recent)) {
+        if (static_cast<std::size_t>(titleId) >= rows.size()) continue;
+        for (const auto& [other, count] : rows[titleId]) scores[other] += count;
+    }
+
+    std::vector<Pair> candidates;
+    candidates.reserve(scores.size());
+    for (const auto& [other, score] : scores) {
+        if (std::ranges::find(history, other) == history.end()) candidates.push_back({other, score});
+    }
+    return topOf(std::move(candidates), k);
+}
\ No newline at end of file
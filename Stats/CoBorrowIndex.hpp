@@ -0,0 +1,45 @@
+#ifndef FINAL_PROJECT_COBORROWINDEX_HPP
+#define FINAL_PROJECT_COBORROWINDEX_HPP
+
+#include <cstdint>
+#include <vector>
+#include "Stats/Memory.hpp"
+
+/* "Patrons who borrowed this also borrowed..." A sparse title x title matrix counting how
+ * many patrons borrowed both, updated on each checkout. Titles are identified by the ID of
+ * their first copy so copies of the same title don't recommend each other.
+ *
+ * Memory is bounded two ways: each row keeps at most MAX_ROW neighbours (when it's full the
+ * oldest of the lowest-count pairs makes room), and only the last MAX_HISTORY distinct titles
+ * a patron borrowed are paired with new checkouts. */
+class CoBorrowIndex {
+public:
+    static constexpr std::size_t MAX_ROW = 64;
+    static constexpr std::size_t MAX_HISTORY = 100;
+    static constexpr std::size_t RECENT_HISTORY = 20;  // Titles forPatron() draws from
+
+private:
+    struct Pair {
+        int titleId;
+        std::uint32_t count;
+    };
+
+    static constexpr auto POOL = Memory::Pool::Statistics;
+
+    Memory::Vector<Memory::Vector<Pair, POOL>, POOL> rows;            // Title ID -> neighbours, unsorted
+    Memory::HashMap<int, Memory::Vector<int, POOL>, POOL> histories;  // Patron ID -> distinct titles, oldest first
+
+    void bump(int from, int to);
+    static std::vector<int> topOf(std::vector<Pair> candidates, std::size_t k);
+
+public:
+    void recordCheckout(int patronId, int titleId);
+    void clear();
+
+    // Most co-borrowed first
+    [[nodiscard]] std::vector<int> similar(int titleId, std::size_t k) const;
+    // Neighbours of everything the patron borrowed, minus what they've already had
+    [[nodiscard]] std::vector<int> forPatron(int patronId, std::size_t k) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "Memory.hpp"
+#include <atomic>
+#include <sstream>
+
+namespace {
+    using Memory::POOL_COUNT;
+
+    // Catalog containers only allocate while loading or growing, so shared atomics are cheap enough
+    struct Counters {
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> blocks{0};
+    };
+
+    std::array<Counters, POOL_COUNT> counters;
+}
+
+Memory::Usage Memory::Snapshot::total() const {
+    Usage sum;
+    for (const Usage& pool : pools) sum += pool;
+    return sum;
+}
+
+const char* Memory::poolName(const Pool pool) {
+    switch (pool) {
+        case Pool::BookObjects: return "bookObjects";
+        case Pool::PatronObjects: return "patronObjects";
+        case Pool::Strings: return "strings";
+        case Pool::BorrowedLists: return "borrowedLists";
+        case Pool::Transactions: return "transactions";
+        case Pool::Snapshot: return "snapshot";
+        case Pool::Indexes: return "indexes";
+        case Pool::Statistics: return "statistics";
+        default: return "unknown";
+    }
+}
+
+void Memory::allocated(const Pool pool, const std::size_t bytes) {
+    Counters& c = counters[static_cast<std::size_t>(pool)];
+    c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    c.blocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Memory::freed(const Pool pool, const std::size_t bytes) {
+    Counters& c = counters[static_cast<std::size_t>(pool)];
+    c.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    c.blocks.fetch_sub(1, std::memory_order_relaxed);
+}
+
+Memory::Snapshot Memory::collect() {
+    Snapshot snapshot;
+    for (std::size_t i = 0; i < POOL_COUNT; ++i) {
+        snapshot.pools[i].bytes = counters[i].bytes.load(std::memory_order_relaxed);
+        snapshot.pools[i].blocks = counters[i].blocks.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+std::string Memory::toJson(const Snapshot& snapshot) {
+    std::ostringstream out;
+    out << "{\n";
+
+    for (std::size_t i = 0; i < POOL_COUNT; ++i) {
+        const Usage& u = snapshot.pools[i];
+        out << "  \"" << poolName(static_cast<Pool>(i)) << "\": {\"bytes\": " << u.bytes
+            << ", \"blocks\": " << u.blocks << "},\n";
+    }
+
+    const Usage total = snapshot.total();
+    out << "  \"total\": {\"bytes\": " << total.bytes << ", \"blocks\": " << total.blocks << "}\n";
+    out << "}\n";
+    return out.str();
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef FINAL_PROJECT_MEMORY_HPP
+#define FINAL_PROJECT_MEMORY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/* Heap bytes held by the catalog, broken down by what they're for.
+ *
+ * Containers Library owns privately use Memory::Allocator, which adds every allocation
+ * to its pool's counters and takes it off again when it's freed, so the counts are exactly
+ * what was asked of the allocator rather than a guess from element counts. Book objects
+ * count themselves in Book::operator new. The few containers that are part of a public
+ * API (Library::getBooks(), Book's strings...) keep std::allocator and get measured
+ * from their capacity when a report is taken, which is the same number for vectors
+ * and strings.
+ *
+ * Bytes are what was requested. malloc rounds each block up and adds a header of its own,
+ * so budget roughly 16 more bytes per block on top. */
+namespace Memory {
+    enum class Pool : std::uint8_t {
+        BookObjects, PatronObjects, Strings, BorrowedLists, Transactions, Snapshot, Indexes, Statistics,
+        Count
+    };
+    constexpr std::size_t POOL_COUNT = static_cast<std::size_t>(Pool::Count);
+
+    struct Usage {
+        std::uint64_t bytes = 0;
+        std::uint64_t blocks = 0;
+
+        Usage& operator+=(const Usage& other) {
+            bytes += other.bytes;
+            blocks += other.blocks;
+            return *this;
+        }
+    };
+
+    struct Snapshot {
+        std::array<Usage, POOL_COUNT> pools;
+
+        [[nodiscard]] Usage& operator[](Pool p) { return pools[static_cast<std::size_t>(p)]; }
+        [[nodiscard]] const Usage& operator[](Pool p) const { return pools[static_cast<std::size_t>(p)]; }
+        [[nodiscard]] Usage total() const;
+    };
+
+    const char* poolName(Pool pool);
+
+    void allocated(Pool pool, std::size_t bytes);
+    void freed(Pool pool, std::size_t bytes);
+    // Process wide, covers every Library and any snapshot still holding chunks
+    Snapshot collect();
+
+    // {"bookObjects": {"bytes": ..., "blocks": ...}, ..., "total": {...}}
+    std::string toJson(const Snapshot& snapshot);
+
+    // What a std::string or std::vector got from std::allocator, for the ones we can't give ours
+    inline Usage heapOf(const std::string& s) {
+        static const std::size_t shortCapacity = std::string().capacity();
+        if (s.capacity() <= shortCapacity) return {};  // Still in the short string buffer
+        return {s.capacity() + 1, 1};
+    }
+
+    template<typename T, typename A>
+    Usage heapOf(const std::vector<T, A>& v) {
+        if (v.capacity() == 0) return {};
+        return {v.capacity() * sizeof(T), 1};
+    }
+
+    template<typename T, Pool P>
+    struct Allocator {
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = Allocator<U, P>; };
+
+        Allocator() = default;
+        template<typename U>
+        Allocator(const Allocator<U, P>&) {}
+
+        T* allocate(const std::size_t n) {
+            T* p = std::allocator<T>().allocate(n);
+            allocated(P, n * sizeof(T));
+            return p;
+        }
+
+        void deallocate(T* p, const std::size_t n) {
+            freed(P, n * sizeof(T));
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template<typename U>
+        bool operator==(const Allocator<U, P>&) const { return true; }
+    };
+
+    // Lets a string keyed container be searched with a string_view without building a key
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(const std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    template<Pool P>
+    using String = std::basic_string<char, std::char_traits<char>, Allocator<char, P>>;
+
+    template<typename T, Pool P>
+    using Vector = std::vector<T, Allocator<T, P>>;
+
+    template<typename K, typename V, Pool P, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+    using HashMap = std::unordered_map<K, V, Hash, Eq, Allocator<std::pair<const K, V>, P>>;
+
+    template<typename K, Pool P>
+    using HashSet = std::unordered_set<K, std::hash<K>, std::equal_to<K>, Allocator<K, P>>;
+
+    template<typename K, Pool P>
+    using OrderedSet = std::set<K, std::less<>, Allocator<K, P>>;
+}
+
+#endif
\ No newline at end of file
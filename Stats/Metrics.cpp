@@ -0,0 +1,190 @@
+#include "Metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <sstream>
+
+namespace {
+    using Metrics::BUCKET_COUNT;
+    using Metrics::OP_COUNT;
+
+    struct Counters {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> timed{0};
+        std::atomic<std::uint64_t> totalNanos{0};
+        std::atomic<std::uint64_t> maxNanos{0};
+        std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+    };
+
+    // One per live thread. Only the owning thread writes, so updates are a plain load and
+    // store; collect() may read at any time and just sees a slightly older value.
+    struct Slab {
+        std::atomic<bool> owned{true};
+        Slab* next = nullptr;  // Set before the slab is published, never changes after
+        std::array<std::uint32_t, OP_COUNT> ticks{};  // Sampling counters, owner only
+        std::array<Counters, OP_COUNT> ops;
+    };
+
+    std::atomic<Slab*> slabs{nullptr};
+    std::atomic<bool> enabledFlag{true};
+
+    void add(std::atomic<std::uint64_t>& counter, const std::uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    Slab* acquireSlab() {
+        // Reuse one left behind by a finished thread, its counts stay in the totals
+        for (Slab* s = slabs.load(std::memory_order_acquire); s; s = s->next) {
+            bool expected = false;
+            if (s->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) return s;
+        }
+
+        auto* slab = new Slab();
+        slab->next = slabs.load(std::memory_order_relaxed);
+        while (!slabs.compare_exchange_weak(slab->next, slab, std::memory_order_release, std::memory_order_relaxed)) {}
+        return slab;
+    }
+
+    // Slabs are never freed: other threads' thread_local destructors can still run during exit
+    struct SlabOwner {
+        Slab* slab = acquireSlab();
+        ~SlabOwner() { slab->owned.store(false, std::memory_order_release); }
+    };
+
+    Slab& localSlab() {
+        thread_local SlabOwner owner;
+        return *owner.slab;
+    }
+}
+
+std::size_t Metrics::bucketOf(const std::uint64_t nanos) {
+    constexpr std::uint64_t linear = 1u << SUB_BUCKET_BITS;
+    if (nanos < linear) return static_cast<std::size_t>(nanos);
+
+    const int exponent = std::bit_width(nanos) - 1;
+    if (exponent > MAX_EXPONENT) return BUCKET_COUNT - 1;
+
+    const auto sub = static_cast<std::size_t>((nanos >> (exponent - SUB_BUCKET_BITS)) & (linear - 1));
+    return (static_cast<std::size_t>(exponent - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + sub;
+}
+
+std::uint64_t Metrics::bucketLow(const std::size_t bucket) {
+    constexpr std::size_t linear = 1u << SUB_BUCKET_BITS;
+    if (bucket < linear) return bucket;
+
+    const int exponent = static_cast<int>(bucket >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS - 1;
+    const std::uint64_t sub = bucket & (linear - 1);
+    return (linear + sub) << (exponent - SUB_BUCKET_BITS);
+}
+
+std::uint64_t Metrics::OpStats::percentileNanos(const double p) const {
+    if (timed == 0) return 0;
+
+    const auto target = static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(timed)));
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < BUCKET_COUNT; ++b) {
+        seen += buckets[b];
+        if (seen >= std::max<std::uint64_t>(target, 1)) {
+            // Middle of the bucket, but never past the largest value actually seen
+            const std::uint64_t low = bucketLow(b);
+            const std::uint64_t high = b + 1 < BUCKET_COUNT ? bucketLow(b + 1) : low;
+            return std::min(low + (high - low) / 2, maxNanos);
+        }
+    }
+    return maxNanos;
+}
+
+const char* Metrics::opName(const Op op) {
+    switch (op) {
+        case Op::LoadData: return "loadData";
+        case Op::SaveData: return "saveData";
+        case Op::Checkout: return "checkoutBook";
+        case Op::Return: return "returnBook";
+        case Op::FindBook: return "findBook";
+        case Op::FindPatron: return "findPatron";
+        case Op::SearchByTitle: return "searchBooksByTitle";
+        case Op::SearchByAuthor: return "searchBooksByAuthor";
+        case Op::SearchByGenre: return "searchBooksByGenre";
+        case Op::RankedSearch: return "rankedSearch";
+        default: return "unknown";
+    }
+}
+
+void Metrics::setEnabled(const bool on) {
+    enabledFlag.store(on, std::memory_order_relaxed);
+}
+
+bool Metrics::enabled() {
+    return enabledFlag.load(std::memory_order_relaxed);
+}
+
+void Metrics::record(const Op op, const std::uint64_t nanos) {
+    Counters& c = localSlab().ops[static_cast<std::size_t>(op)];
+    add(c.timed, 1);
+    add(c.totalNanos, nanos);
+    add(c.buckets[bucketOf(nanos)], 1);
+    if (nanos > c.maxNanos.load(std::memory_order_relaxed)) c.maxNanos.store(nanos, std::memory_order_relaxed);
+}
+
+Metrics::Snapshot Metrics::collect() {
+    Snapshot result;
+
+    for (const Slab* s = slabs.load(std::memory_order_acquire); s; s = s->next) {
+        for (std::size_t op = 0; op < OP_COUNT; ++op) {
+            const Counters& c = s->ops[op];
+            OpStats& out = result.ops[op];
+
+            out.calls += c.calls.load(std::memory_order_relaxed);
+            out.timed += c.timed.load(std::memory_order_relaxed);
+            out.totalNanos += c.totalNanos.load(std::memory_order_relaxed);
+            out.maxNanos = std::max(out.maxNanos, c.maxNanos.load(std::memory_order_relaxed));
+            for (std::size_t b = 0; b < BUCKET_COUNT; ++b) out.buckets[b] += c.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+
+    return result;
+}
+
+std::string Metrics::toJson(const Snapshot& snapshot) {
+    std::ostringstream out;
+    out << "{\n";
+
+    for (std::size_t i = 0; i < OP_COUNT; ++i) {
+        const auto op = static_cast<Op>(i);
+        const OpStats& s = snapshot[op];
+
+        out << "  \"" << opName(op) << "\": {"
+            << "\"calls\": " << s.calls
+            << ", \"timed\": " << s.timed
+            << ", \"meanNanos\": " << static_cast<std::uint64_t>(s.meanNanos())
+            << ", \"p50Nanos\": " << s.percentileNanos(0.50)
+            << ", \"p90Nanos\": " << s.percentileNanos(0.90)
+            << ", \"p99Nanos\": " << s.percentileNanos(0.99)
+            << ", \"maxNanos\": " << s.maxNanos
+            << "}" << (i + 1 < OP_COUNT ? "," : "") << "\n";
+    }
+
+    out << "}\n";
+    return out.str();
+}
+
+Metrics::ScopedTimer::ScopedTimer(const Op op, const std::uint32_t sampleEvery)
+    : op(op), active(false) {
+    if (!enabled()) return;
+
+    Slab& slab = localSlab();
+    const auto index = static_cast<std::size_t>(op);
+    add(slab.ops[index].calls, 1);
+
+    if ((slab.ticks[index]++ & (sampleEvery - 1)) == 0) {
+        active = true;
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+Metrics::ScopedTimer::~ScopedTimer() {
+    if (!active) return;
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    record(op, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef FINAL_PROJECT_METRICS_HPP
+#define FINAL_PROJECT_METRICS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/* Call counts and latency histograms for the Library operations worth watching.
+ *
+ * Every thread records into its own slab of counters (plain relaxed stores, no locked
+ * instructions), and collect() sums all slabs without stopping anyone. A slab outlives its
+ * thread and is reused by the next new thread, so short-lived save threads don't pile up.
+ *
+ * Histograms are log-linear like HDR histograms: 8 buckets per power of two, so any
+ * percentile is within about 12% of the real value. Lookups that only take tens of
+ * nanoseconds are timed one call in 64 (the call count is still exact), otherwise reading
+ * the clock would cost more than the lookup. When disabled a timer does nothing but check
+ * one flag. */
+namespace Metrics {
+    enum class Op : std::uint8_t {
+        LoadData, SaveData, Checkout, Return, FindBook, FindPatron,
+        SearchByTitle, SearchByAuthor, SearchByGenre, RankedSearch,
+        Count
+    };
+    constexpr std::size_t OP_COUNT = static_cast<std::size_t>(Op::Count);
+
+    constexpr int SUB_BUCKET_BITS = 3;
+    constexpr int MAX_EXPONENT = 47;  // ~39 hours in nanoseconds, anything longer lands in the last bucket
+    constexpr std::size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) << SUB_BUCKET_BITS;
+
+    std::size_t bucketOf(std::uint64_t nanos);
+    std::uint64_t bucketLow(std::size_t bucket);
+
+    struct OpStats {
+        std::uint64_t calls = 0;
+        std::uint64_t timed = 0;      // Calls that were sampled into the histogram
+        std::uint64_t totalNanos = 0; // Over the timed calls
+        std::uint64_t maxNanos = 0;
+        std::array<std::uint64_t, BUCKET_COUNT> buckets{};
+
+        [[nodiscard]] double meanNanos() const { return timed ? static_cast<double>(totalNanos) / static_cast<double>(timed) : 0.0; }
+        [[nodiscard]] std::uint64_t percentileNanos(double p) const;
+    };
+
+    struct Snapshot {
+        std::array<OpStats, OP_COUNT> ops;
+        [[nodiscard]] const OpStats& operator[](Op op) const { return ops[static_cast<std::size_t>(op)]; }
+    };
+
+    const char* opName(Op op);
+
+    void setEnabled(bool on);
+    bool enabled();
+
+    // Adds one timed call, the call itself is counted by ScopedTimer
+    void record(Op op, std::uint64_t nanos);
+    Snapshot collect();
+
+    // {"findBook": {"calls": ..., "p50Nanos": ...}, ...}
+    std::string toJson(const Snapshot& snapshot);
+
+    class ScopedTimer {
+    private:
+        Op op;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        // sampleEvery must be a power of two
+        explicit ScopedTimer(Op op, std::uint32_t sampleEvery = 1);
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef FINAL_PROJECT_PARALLELSCAN_HPP
+#define FINAL_PROJECT_PARALLELSCAN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// One per core, or 1 if the platform won't say
+inline unsigned scanThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/* Splits items into one contiguous slice per thread, folds each slice into its own
+ * Partial (no sharing, no locks) and merges the partials on the calling thread in slice
+ * order. Items only needs size() and operator[], so it works on a snapshot's ChunkedVectors.
+ *   accumulate(Partial&, const Item&)
+ *   merge(Partial& into, Partial&& from)
+ * Small inputs aren't worth the thread startup and run inline. */
+template<typename Partial, typename Items, typename Accumulate, typename Merge>
+Partial parallelAggregate(const Items& items, unsigned threads, Accumulate accumulate, Merge merge,
+                          const Partial& identity = Partial{}) {
+    constexpr std::size_t MIN_PER_THREAD = 16 * 1024;
+
+    const std::size_t n = items.size();
+    threads = static_cast<unsigned>(std::clamp<std::size_t>(n / MIN_PER_THREAD, 1, std::max(1u, threads)));
+
+    auto scan = [&](Partial& partial, const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) accumulate(partial, items[i]);
+    };
+
+    if (threads == 1) {
+        Partial result = identity;
+        scan(result, 0, n);
+        return result;
+    }
+
+    std::vector<Partial> partials(threads, identity);
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    for (unsigned t = 0; t < threads; ++t) {
+        const std::size_t begin = n * t / threads;
+        const std::size_t end = n * (t + 1) / threads;
+        auto work = [&, t, begin, end]() {
+            try {
+                scan(partials[t], begin, end);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+        // The calling thread takes the last slice instead of sitting idle
+        if (t + 1 < threads) workers.emplace_back(work);
+        else work();
+    }
+    for (auto& worker : workers) worker.join();
+
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    Partial result = std::move(partials[0]);
+    for (unsigned t = 1; t < threads; ++t) merge(result, std::move(partials[t]));
+    return result;
+}
+
+#endif
\ No newline at end of file
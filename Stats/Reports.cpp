@@ -0,0 +1,68 @@
+#include "Reports.hpp"
+#include <unordered_map>
+#include <vector>
+#include "Stats/ParallelScan.hpp"
+
+namespace {
+    constexpr std::int8_t NO_GENRE = -1;
+
+    // Book ID -> genre, built once so the scan threads only read a flat array
+    std::vector<std::int8_t> genresById(const CatalogSnapshot& snapshot) {
+        std::vector<std::int8_t> genres;
+        for (const auto& record : snapshot.books) {
+            const auto id = static_cast<std::size_t>(record.id);
+            if (id >= genres.size()) genres.resize(id + 1, NO_GENRE);
+            genres[id] = static_cast<std::int8_t>(record.genre);
+        }
+        return genres;
+    }
+
+    struct MonthlyPartial {
+        std::unordered_map<int, Reports::GenreCounts> months;
+
+        // The log is mostly in date order, so remember the last day's month instead of
+        // converting and hashing every transaction
+        int lastDay = 0;
+        Reports::GenreCounts* lastCounts = nullptr;
+    };
+}
+
+std::unordered_map<int, std::uint32_t> Reports::borrowingFrequency(const CatalogSnapshot& snapshot, const unsigned threads) {
+    using Counts = std::unordered_map<int, std::uint32_t>;
+
+    return parallelAggregate<Counts>(snapshot.transactions, threads,
+        [](Counts& counts, const Transaction& t) {
+            if (t.getType() == TransactionType::Checkout) counts[t.getPatronID()]++;
+        },
+        [](Counts& into, Counts&& from) {
+            for (const auto& [patronId, count] : from) into[patronId] += count;
+        });
+}
+
+std::map<int, Reports::GenreCounts> Reports::genreTrendsByMonth(const CatalogSnapshot& snapshot, const unsigned threads) {
+    const auto genres = genresById(snapshot);
+
+    auto merged = parallelAggregate<MonthlyPartial>(snapshot.transactions, threads,
+        [&genres](MonthlyPartial& partial, const Transaction& t) {
+            if (t.getType() != TransactionType::Checkout) return;
+
+            const auto bookId = static_cast<std::size_t>(t.getBookID());
+            if (bookId >= genres.size() || genres[bookId] == NO_GENRE) return;
+
+            if (!partial.lastCounts || t.getDayNumber() != partial.lastDay) {
+                const Date date = t.getDate();
+                partial.lastDay = t.getDayNumber();
+                // Elements of an unordered_map don't move on rehash, so the pointer stays good
+                partial.lastCounts = &partial.months[date.getYear() * 12 + date.getMonth() - 1];
+            }
+            (*partial.lastCounts)[static_cast<std::size_t>(genres[bookId])]++;
+        },
+        [](MonthlyPartial& into, MonthlyPartial&& from) {
+            for (const auto& [month, counts] : from.months) {
+                auto& total = into.months[month];
+                for (std::size_t g = 0; g < total.size(); ++g) total[g] += counts[g];
+            }
+        });
+
+    return {merged.months.begin(), merged.months.end()};
+}
\ No newline at end of file
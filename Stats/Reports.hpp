@@ -0,0 +1,25 @@
+#ifndef FINAL_PROJECT_REPORTS_HPP
+#define FINAL_PROJECT_REPORTS_HPP
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include "CatalogSnapshot.hpp"
+#include "Stats/CirculationStats.hpp"
+
+/* Ad-hoc reports over the whole history. These scan every transaction in a snapshot, spread
+ * over threads (see ParallelScan.hpp), so they can run while the desk keeps working.
+ * Pass threads = 1 to run on the calling thread only. */
+namespace Reports {
+    using GenreCounts = std::array<std::uint32_t, CirculationStats::GENRE_COUNT>;
+
+    // Patron ID -> checkouts
+    std::unordered_map<int, std::uint32_t> borrowingFrequency(const CatalogSnapshot& snapshot, unsigned threads);
+
+    // year * 12 + (month - 1) -> checkouts per genre, oldest month first.
+    // Books no longer in the catalog aren't counted.
+    std::map<int, GenreCounts> genreTrendsByMonth(const CatalogSnapshot& snapshot, unsigned threads);
+}
+
+#endif
\ No newline at end of file
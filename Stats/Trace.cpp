@@ -0,0 +1,163 @@
+#include "Trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+namespace {
+    struct Event {
+        // 2i+1 while event i is being written, 2i+2 once it's complete
+        std::atomic<std::uint64_t> sequence{0};
+        const char* name = nullptr;
+        const char* category = nullptr;
+        std::uint64_t startNanos = 0;
+        std::uint64_t durationNanos = 0;
+        std::uint32_t thread = 0;
+        char detail[64] = {};
+    };
+
+    // The buffer is never freed once allocated, a span on another thread may still be writing
+    std::unique_ptr<Event[]> events;
+    std::size_t mask = 0;
+    std::atomic<std::uint64_t> nextEvent{0};
+    std::atomic<bool> enabledFlag{false};
+    std::string outputPath;
+    const auto origin = std::chrono::steady_clock::now();
+
+    std::uint32_t threadNumber() {
+        static std::atomic<std::uint32_t> nextThread{1};
+        thread_local const std::uint32_t number = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return number;
+    }
+
+    std::uint64_t sinceOrigin(const std::chrono::steady_clock::time_point t) {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t - origin).count());
+    }
+
+    void writeEscaped(std::ostream& out, const char* s) {
+        for (; *s; ++s) {
+            const auto c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\') out << '\\' << *s;
+            else if (c < 0x20) out << ' ';
+            else out << *s;
+        }
+    }
+}
+
+void Trace::configure(const int argc, char* argv[]) {
+    std::string path;
+
+    if (const char* env = std::getenv("LIBRARY_TRACE"); env && *env && std::strcmp(env, "0") != 0) {
+        path = std::strcmp(env, "1") == 0 ? "library-trace.json" : env;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--trace") path = "library-trace.json";
+        else if (arg.starts_with("--trace=")) path = std::string(arg.substr(8));
+    }
+
+    if (!path.empty()) start(path);
+}
+
+void Trace::start(const std::string& path, const std::size_t capacity) {
+    if (!events) {
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+        events = std::make_unique<Event[]>(size);
+        mask = size - 1;
+    }
+    outputPath = path;
+    enabledFlag.store(true, std::memory_order_release);
+    std::cout << "Tracing to " << outputPath << std::endl;
+}
+
+void Trace::stop() {
+    if (!enabledFlag.exchange(false)) return;
+    write(outputPath);
+}
+
+bool Trace::enabled() {
+    return enabledFlag.load(std::memory_order_acquire);
+}
+
+bool Trace::write(const std::string& filename) {
+    if (!events) return false;
+
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open trace file for writing: " << filename << std::endl;
+        return false;
+    }
+
+    const std::uint64_t end = nextEvent.load(std::memory_order_acquire);
+    const std::uint64_t first = end > mask + 1 ? end - (mask + 1) : 0;
+    std::size_t written = 0;
+
+    out << "{\"traceEvents\":[\n";
+    for (std::uint64_t i = first; i < end; ++i) {
+        const Event& slot = events[i & mask];
+
+        // Skip slots that are mid-write or were already overwritten by a newer event
+        const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * i + 2) continue;
+        Event copy;
+        copy.name = slot.name;
+        copy.category = slot.category;
+        copy.startNanos = slot.startNanos;
+        copy.durationNanos = slot.durationNanos;
+        copy.thread = slot.thread;
+        std::memcpy(copy.detail, slot.detail, sizeof(copy.detail));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+        out << (written++ ? ",\n" : "") << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << copy.thread
+            << ",\"ts\":" << static_cast<double>(copy.startNanos) / 1000.0
+            << ",\"dur\":" << static_cast<double>(copy.durationNanos) / 1000.0
+            << ",\"name\":\"";
+        writeEscaped(out, copy.name);
+        out << "\",\"cat\":\"";
+        writeEscaped(out, copy.category);
+        out << "\"";
+        if (copy.detail[0]) {
+            out << ",\"args\":{\"detail\":\"";
+            writeEscaped(out, copy.detail);
+            out << "\"}";
+        }
+        out << "}";
+    }
+    out << "\n]}\n";
+
+    std::cout << "Saved " << written << " trace events to " << filename << std::endl;
+    return true;
+}
+
+Trace::Span::Span(const char* name, const char* category, const std::string_view detail)
+    : name(name), category(category), detail(detail), active(enabled()) {
+    if (active) begin = std::chrono::steady_clock::now();
+}
+
+Trace::Span::~Span() {
+    if (!active) return;
+    const auto finish = std::chrono::steady_clock::now();
+
+    const std::uint64_t i = nextEvent.fetch_add(1, std::memory_order_relaxed);
+    Event& slot = events[i & mask];
+
+    slot.sequence.store(2 * i + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.name = name;
+    slot.category = category;
+    slot.startNanos = sinceOrigin(begin);
+    slot.durationNanos = sinceOrigin(finish) - slot.startNanos;
+    slot.thread = threadNumber();
+    const std::size_t length = std::min(detail.size(), sizeof(slot.detail) - 1);
+    std::memcpy(slot.detail, detail.data(), length);
+    slot.detail[length] = '\0';
+
+    slot.sequence.store(2 * i + 2, std::memory_order_release);
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef FINAL_PROJECT_TRACE_HPP
+#define FINAL_PROJECT_TRACE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/* Timeline tracing for startup, saving and the GUI, written as Chrome trace-event JSON
+ * (open it in chrome://tracing or ui.perfetto.dev).
+ *
+ * Off unless LIBRARY_TRACE is set (to an output path, or 1 for library-trace.json) or the
+ * app is started with --trace[=path]. Spans go into a fixed ring buffer: a writer claims a
+ * slot with one atomic add and publishes it with a sequence number, so nothing blocks and
+ * a long session just keeps the most recent events. When off, a span only checks a flag. */
+namespace Trace {
+    // Reads LIBRARY_TRACE and --trace, starts tracing if either asks for it
+    void configure(int argc, char* argv[]);
+    void start(const std::string& outputPath, std::size_t capacity = 1 << 16);
+    // Writes the buffer to the output path and stops recording
+    void stop();
+    bool enabled();
+
+    bool write(const std::string& filename);
+
+    class Span {
+    private:
+        const char* name;
+        const char* category;
+        std::string_view detail;
+        std::chrono::steady_clock::time_point begin;
+        bool active;
+
+    public:
+        // name and category must be string literals, detail (a file name, search term...)
+        // must outlive the span and is cut to fit the event
+        Span(const char* name, const char* category, std::string_view detail = {});
+        ~Span();
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -42,6 +42,28 @@ std::string Date::toString() const {
     return oss.str();
 }
 
+// Civil calendar <-> day count (proleptic Gregorian, day 0 is 01/01/1970)
+int Date::toDayNumber() const {
+    const int y = month <= 2 ? year - 1 : year;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const int yearOfEra = y - era * 400;
+    const int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+Date Date::fromDayNumber(int dayNumber) {
+    dayNumber += 719468;
+    const int era = (dayNumber >= 0 ? dayNumber : dayNumber - 146096) / 146097;
+    const int dayOfEra = dayNumber - era * 146097;
+    const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int mp = (5 * dayOfYear + 2) / 153;
+    const int d = dayOfYear - (153 * mp + 2) / 5 + 1;
+    const int m = mp < 10 ? mp + 3 : mp - 9;
+    return {d, m, yearOfEra + era * 400 + (m <= 2 ? 1 : 0)};
+}
+
 // Can't believe I ACTUALLY had to overload this just for overdue dates
 bool Date::operator==(const Date& other) const { return day == other.day && month == other.month && year == other.year; }
 
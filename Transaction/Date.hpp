@@ -14,9 +14,17 @@ public:
     Date();
     Date(int day, int month, int year);
 
+    [[nodiscard]] int getDay() const { return day; }
+    [[nodiscard]] int getMonth() const { return month; }
+    [[nodiscard]] int getYear() const { return year; }
+
     [[nodiscard]] Date addDays(int days) const;
     [[nodiscard]] std::string toString() const;
 
+    // Days since 01/01/1970, used for compact storage and date arithmetic
+    [[nodiscard]] int toDayNumber() const;
+    static Date fromDayNumber(int dayNumber);
+
     bool operator==(const Date& other) const;
     bool operator!=(const Date& other) const;
     bool operator<(const Date& other) const;
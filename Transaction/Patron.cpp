@@ -13,7 +13,7 @@ Patron::Patron(std::string name, const int id)
     if (id >= nextId) nextId = id + 1;
 }
 
-void Patron::borrowBook(Book* book) {
+void Patron::borrowBook(Book* book, const Date& on) {
     if (!book) throw std::invalid_argument("Cannot borrow null book.");
 
     if (book->getStatus() != Book::BookStatus::Available) throw std::runtime_error("Book '" + book->getTitle() + "' is not available.");
@@ -22,9 +22,7 @@ void Patron::borrowBook(Book* book) {
     if (it != borrowedBooks.end()) throw std::runtime_error("Patron already has this book borrowed.");
 
     borrowedBooks.push_back(book);
-    book->checkout(id);  // Use the new checkout method
-
-    std::cout << "Book '" << book->getTitle() << "' borrowed successfully by " << name << "." << std::endl;
+    book->checkout(id, on);  // Use the new checkout method
 }
 
 void Patron::returnBook(Book* book) {
@@ -35,8 +33,6 @@ void Patron::returnBook(Book* book) {
 
     borrowedBooks.erase(it);
     book->returnBook();  // Use the new return method
-
-    std::cout << "Book '" << book->getTitle() << "' returned successfully by " << name << "." << std::endl;
 }
 
 void Patron::displayPatron() const {
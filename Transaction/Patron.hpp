@@ -5,27 +5,32 @@
 #include <vector>
 #include <iostream>
 #include "Book/Book.hpp"
+#include "Stats/Memory.hpp"
 
 class Patron {
+public:
+    using BorrowedList = Memory::Vector<Book*, Memory::Pool::BorrowedLists>;
+
 private:
     std::string name;
     int id;
-    std::vector<Book*> borrowedBooks;
+    BorrowedList borrowedBooks;
     static int nextId;
 
 public:
     explicit Patron(std::string name);
     Patron(std::string name, int id);
 
-    void borrowBook(Book* book);
+    void borrowBook(Book* book, const Date& on = Date());
     void returnBook(Book* book);
     void displayPatron() const;
     void clearBorrowedBooks() { borrowedBooks.clear(); }
     void addBorrowedBook(Book* book) { borrowedBooks.push_back(book); }
+    void removeBorrowedBook(const Book* book) { std::erase(borrowedBooks, book); }
 
-    [[nodiscard]] std::string getName() const { return name; }
+    [[nodiscard]] const std::string& getName() const { return name; }
     [[nodiscard]] int getId() const { return id; }
-    [[nodiscard]] const std::vector<Book*>& getBorrowedBooks() const { return borrowedBooks; }
+    [[nodiscard]] const BorrowedList& getBorrowedBooks() const { return borrowedBooks; }
 
     bool operator==(const Patron& other) const;
     friend std::ostream& operator<<(std::ostream& os, const Patron& p);
@@ -1,39 +1,34 @@
 #include "Transaction.hpp"
 #include <iostream>
-#include <utility>
-#include <algorithm>
-#include <cctype>
+#include "RecordFormats.hpp"
 
-Transaction::Transaction(const int pid, std::string bookTitle, const TransactionType type)
+Transaction::Transaction(const int pid, const int bookId, const TransactionType type)
     : patronID(pid)
-    , bookTitle(std::move(bookTitle))
-    , type(type)
-    , date() {}
+    , bookID(bookId)
+    , dayNumber(Date().toDayNumber())
+    , type(type) {}
 
-Transaction::Transaction(const int pid, std::string bookTitle, const TransactionType type, const Date& date)
+Transaction::Transaction(const int pid, const int bookId, const TransactionType type, const Date& date)
     : patronID(pid)
-    , bookTitle(std::move(bookTitle))
-    , type(type)
-    , date(date) {}
+    , bookID(bookId)
+    , dayNumber(date.toDayNumber())
+    , type(type) {}
 
 void Transaction::displayTransaction() const {
-    std::cout << "[" << date << "] Patron " << patronID << " "
-              << typeToString() << " \"" << bookTitle << "\"" << std::endl;
+    std::cout << "[" << getDate() << "] Patron " << patronID << " "
+              << typeToString() << " book #" << bookID << std::endl;
 }
 
-std::string Transaction::typeToString() const {
+std::string_view Transaction::typeToString() const {
     return type == TransactionType::Checkout ? "Check Out" : "Return";
 }
 
-// Annoying grammar lol
-TransactionType Transaction::stringToType(const std::string& str) {
-    std::string lower = str;
-    std::ranges::transform(lower, lower.begin(), ::tolower);
+// Annoying grammar lol, all the spellings are in RecordFormats.hpp
+TransactionType Transaction::stringToType(std::string_view str) {
+    if (!str.empty() && str.back() == '.') str.remove_suffix(1);
 
-    if (!lower.empty() && lower.back() == '.') lower.pop_back();
-
-    if (lower == "checked out" || lower == "checkout" || lower == "checkout." || lower == "checked_out" || lower == "checked out.") return TransactionType::Checkout;
-    if (lower == "return" || lower == "return." || lower == "returned") return TransactionType::Return;
+    TransactionType type;
+    if (Schema::EnumDecoder<TransactionType>::decode(str, type)) return type;
 
     return TransactionType::Return;
 }
\ No newline at end of file
@@ -1,32 +1,37 @@
 #ifndef FINAL_PROJECT_TRANSACTION_H
 #define FINAL_PROJECT_TRANSACTION_H
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include "Date.hpp"
 
-enum class TransactionType {
+enum class TransactionType : std::uint8_t {
     Checkout,
     Return
 };
 
+// Books are referenced by ID and dates by day number, so a transaction is 16 bytes instead of ~60
 class Transaction {
     int patronID;
-    std::string bookTitle;
+    int bookID;
+    int dayNumber;
     TransactionType type;
-    Date date;
 
 public:
-    Transaction(int pid, std::string bookTitle, TransactionType type);
-    Transaction(int pid, std::string bookTitle, TransactionType type, const Date& date);
+    Transaction(int pid, int bookId, TransactionType type);
+    Transaction(int pid, int bookId, TransactionType type, const Date& date);
 
     void displayTransaction() const;
 
     [[nodiscard]] int getPatronID() const { return patronID; }
-    [[nodiscard]] std::string getBookTitle() const { return bookTitle; }
+    [[nodiscard]] int getBookID() const { return bookID; }
     [[nodiscard]] TransactionType getType() const { return type; }
-    [[nodiscard]] Date getDate() const { return date; }
-    [[nodiscard]] std::string typeToString() const;
+    [[nodiscard]] int getDayNumber() const { return dayNumber; }
+    [[nodiscard]] Date getDate() const { return Date::fromDayNumber(dayNumber); }
+    [[nodiscard]] std::string_view typeToString() const;
 
-    static TransactionType stringToType(const std::string& str);
+    // Takes any spelling old logs used, unknown ones count as a return
+    static TransactionType stringToType(std::string_view str);
 };
 
 #endif
\ No newline at end of file
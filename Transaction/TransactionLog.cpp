@@ -0,0 +1,89 @@
+#include "TransactionLog.hpp"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include "RecordSchema.hpp"
+#include "Stats/Trace.hpp"
+
+namespace {
+    constexpr char MAGIC[4] = {'L', 'T', 'X', 'N'};
+    constexpr char VERSION = 1;
+
+    std::uint32_t zigzag(const int value) {
+        return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+    }
+
+    int unzigzag(const std::uint32_t value) {
+        return static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+    }
+
+    // One record as it sits in the file, see the header for the layout
+    struct PackedTransaction {
+        std::uint32_t patronId = 0;
+        std::uint32_t bookId = 0;
+        std::uint32_t dayAndType = 0;
+    };
+
+    using PackedSchema = Schema::Record<PackedTransaction,
+        Schema::Field<"patronId", &PackedTransaction::patronId>,
+        Schema::Field<"bookId", &PackedTransaction::bookId>,
+        Schema::Field<"dayAndType", &PackedTransaction::dayAndType>>;
+}
+
+void TransactionLog::encode(std::string& out, const Transaction& t, int& previousDay) {
+    const std::uint32_t typeBit = t.getType() == TransactionType::Return ? 1 : 0;
+    PackedSchema::encodeBinary({static_cast<std::uint32_t>(t.getPatronID()), static_cast<std::uint32_t>(t.getBookID()),
+        zigzag(t.getDayNumber() - previousDay) << 1 | typeBit}, out);
+    previousDay = t.getDayNumber();
+}
+
+void TransactionLog::write(const TransactionList& transactions, const std::string& filename) {
+    Trace::Span span("writeTransactionLog", "io", filename);
+    std::string buffer(MAGIC, sizeof(MAGIC));
+    buffer.push_back(VERSION);
+    buffer.reserve(buffer.size() + transactions.size() * 4);
+
+    int previousDay = 0;
+    for (const auto& t : transactions) encode(buffer, t, previousDay);
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("Failed to open file for writing: " + filename);
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.close();
+    if (!file) throw std::runtime_error("Failed to write file: " + filename);
+
+    std::cout << "Saved " << transactions.size() << " items to " << filename
+              << " (" << buffer.size() << " bytes)" << std::endl;
+}
+
+bool TransactionLog::read(TransactionList& transactions, const std::string& filename) {
+    Trace::Span span("readTransactionLog", "io", filename);
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    const std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (buffer.size() < sizeof(MAGIC) + 1 || buffer.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error("Not a transaction log: " + filename);
+    if (buffer[sizeof(MAGIC)] != VERSION) throw std::runtime_error("Unsupported transaction log version: " + filename);
+
+    std::string_view rest(buffer);
+    rest.remove_prefix(sizeof(MAGIC) + 1);
+    int previousDay = 0;
+    int count = 0;
+
+    PackedTransaction packed;
+    while (!rest.empty()) {
+        PackedSchema::decodeBinary(rest, packed);
+
+        const auto type = (packed.dayAndType & 1) ? TransactionType::Return : TransactionType::Checkout;
+        previousDay += unzigzag(packed.dayAndType >> 1);
+
+        transactions.emplace_back(static_cast<int>(packed.patronId), static_cast<int>(packed.bookId), type, Date::fromDayNumber(previousDay));
+        count++;
+    }
+
+    std::cout << "Loaded " << count << " items from " << filename << std::endl;
+    return true;
+}
\ No newline at end of file
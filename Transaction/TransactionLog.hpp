@@ -0,0 +1,26 @@
+#ifndef FINAL_PROJECT_TRANSACTIONLOG_HPP
+#define FINAL_PROJECT_TRANSACTIONLOG_HPP
+
+#include <string>
+#include <cstdint>
+#include "Transaction.hpp"
+#include "ChunkedVector.hpp"
+#include "Stats/Memory.hpp"
+
+/* Binary transaction log, usually 3-5 bytes per record:
+ *   header: "LTXN" + format version byte
+ *   record: varint patronId, varint bookId, varint (zigzag(day - previousDay) << 1 | type)
+ * Day numbers are delta-encoded against the previous record, so a log written
+ * in date order mostly stores a delta of 0 or 1. The varints come from RecordSchema.hpp. */
+// The in-memory log, counted in Memory::Pool::Transactions
+using TransactionList = ChunkedVector<Transaction, 64, Memory::Allocator<Transaction, Memory::Pool::Transactions>>;
+
+namespace TransactionLog {
+    void encode(std::string& out, const Transaction& t, int& previousDay);
+
+    void write(const TransactionList& transactions, const std::string& filename);
+    // Returns false if the file doesn't exist
+    bool read(TransactionList& transactions, const std::string& filename);
+}
+
+#endif
\ No newline at end of file
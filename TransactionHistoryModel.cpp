@@ -0,0 +1,176 @@
+#include "TransactionHistoryModel.hpp"
+#include <algorithm>
+#include <numeric>
+
+TransactionHistoryModel::TransactionHistoryModel(Library* lib, QObject* parent)
+    : QAbstractTableModel(parent)
+    , library(lib)
+    , loadedRows(static_cast<int>(std::min<std::size_t>(PAGE_SIZE, lib->getTransactions().size()))) {
+    library->addListener(this);
+}
+
+TransactionHistoryModel::~TransactionHistoryModel() {
+    library->removeListener(this);
+}
+
+int TransactionHistoryModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : loadedRows;
+}
+
+int TransactionHistoryModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+bool TransactionHistoryModel::canFetchMore(const QModelIndex& parent) const {
+    return !parent.isValid() && static_cast<std::size_t>(loadedRows) < library->getTransactions().size();
+}
+
+void TransactionHistoryModel::fetchMore(const QModelIndex& parent) {
+    if (parent.isValid()) return;
+
+    const int total = static_cast<int>(library->getTransactions().size());
+    const int next = std::min(total, loadedRows + PAGE_SIZE);
+    if (next <= loadedRows) return;
+
+    beginInsertRows(QModelIndex(), loadedRows, next - 1);
+    loadedRows = next;
+    endInsertRows();
+}
+
+const Transaction& TransactionHistoryModel::transactionAt(const int row) const {
+    const auto& transactions = library->getTransactions();
+    return order.empty() ? transactions[row] : transactions[order[row]];
+}
+
+TransactionHistoryModel::Status TransactionHistoryModel::statusOf(const Transaction& t) const {
+    if (t.getType() != TransactionType::Checkout) return Status::Completed;
+
+    // Book ID lookup is a vector index, no scan per row
+    const Book* book = library->findBookById(t.getBookID());
+    if (!book || book->getStatus() != Book::BookStatus::CheckedOut || book->getCurrentPatronId() != t.getPatronID())
+        return Status::Returned;
+
+    return book->isOverdue() ? Status::Overdue : Status::Active;
+}
+
+QString TransactionHistoryModel::statusText(const Transaction& t) const {
+    const Status status = statusOf(t);
+    if (status == Status::Completed) return "Completed";
+    if (status == Status::Returned) return "Returned";
+
+    QString text = "Active";
+    if (status == Status::Overdue) text += " - OVERDUE!";
+
+    const Book* book = library->findBookById(t.getBookID());
+    if (book->getDueDate().has_value()) text += " (Due: " + QString::fromStdString(book->getDueDate()->toString()) + ")";
+    return text;
+}
+
+QVariant TransactionHistoryModel::data(const QModelIndex& index, const int role) const {
+    if (!index.isValid() || role != Qt::DisplayRole || index.row() >= loadedRows) return {};
+
+    const Transaction& t = transactionAt(index.row());
+
+    switch (index.column()) {
+        case DateColumn: return QString::fromStdString(t.getDate().toString());
+        case PatronColumn: return t.getPatronID();
+        case TypeColumn: {
+            const std::string_view type = t.typeToString();
+            return QString::fromUtf8(type.data(), static_cast<qsizetype>(type.size()));
+        }
+        case TitleColumn: {
+            const Book* book = library->findBookById(t.getBookID());
+            return book ? QString::fromStdString(book->getTitle()) : QString("#%1").arg(t.getBookID());
+        }
+        case StatusColumn: return statusText(t);
+        default: return {};
+    }
+}
+
+QVariant TransactionHistoryModel::headerData(const int section, const Qt::Orientation orientation, const int role) const {
+    if (role != Qt::DisplayRole) return {};
+    if (orientation == Qt::Vertical) return section + 1;
+
+    switch (section) {
+        case DateColumn: return "Date";
+        case PatronColumn: return "Patron ID";
+        case TypeColumn: return "Type";
+        case TitleColumn: return "Book Title";
+        case StatusColumn: return "Status";
+        default: return {};
+    }
+}
+
+void TransactionHistoryModel::sort(const int column, const Qt::SortOrder sortOrder) {
+    const auto& transactions = library->getTransactions();
+    const auto total = static_cast<std::uint32_t>(transactions.size());
+
+    beginResetModel();
+
+    std::vector<std::uint32_t> sorted(total);
+    std::iota(sorted.begin(), sorted.end(), 0u);
+
+    // Sort on integer keys so the comparator never builds strings
+    auto sortBy = [&](auto key) {
+        std::ranges::stable_sort(sorted, [&](const std::uint32_t a, const std::uint32_t b) {
+            return key(transactions[a]) < key(transactions[b]);
+        });
+    };
+
+    switch (column) {
+        case DateColumn: {
+            // The log is appended in date order, so usually there's nothing to sort
+            const bool chronological = std::ranges::is_sorted(transactions, {}, &Transaction::getDayNumber);
+            if (!chronological) sortBy([](const Transaction& t) { return t.getDayNumber(); });
+            break;
+        }
+        case PatronColumn: sortBy([](const Transaction& t) { return t.getPatronID(); }); break;
+        case TypeColumn: sortBy([](const Transaction& t) { return static_cast<int>(t.getType()); }); break;
+        case TitleColumn: {
+            // Rank each book by title once, then sort transactions by rank
+            std::vector<const Book*> byTitle(library->getBooks().begin(), library->getBooks().end());
+            std::ranges::sort(byTitle, [](const Book* a, const Book* b) { return a->getTitle() < b->getTitle(); });
+
+            std::vector<std::uint32_t> rank;
+            for (std::uint32_t i = 0; i < byTitle.size(); ++i) {
+                const auto id = static_cast<std::size_t>(byTitle[i]->getId());
+                if (id >= rank.size()) rank.resize(id + 1, UINT32_MAX);
+                rank[id] = i;
+            }
+            sortBy([&rank](const Transaction& t) {
+                const auto id = static_cast<std::size_t>(t.getBookID());
+                return id < rank.size() ? rank[id] : UINT32_MAX;
+            });
+            break;
+        }
+        case StatusColumn: sortBy([this](const Transaction& t) { return static_cast<int>(statusOf(t)); }); break;
+        default: break;
+    }
+
+    if (sortOrder == Qt::DescendingOrder) std::ranges::reverse(sorted);
+
+    // Natural log order doesn't need an index array at all
+    const bool identity = std::ranges::is_sorted(sorted);
+    order = identity ? std::vector<std::uint32_t>() : std::move(sorted);
+    loadedRows = static_cast<int>(std::min<std::size_t>(PAGE_SIZE, total));
+
+    endResetModel();
+}
+
+void TransactionHistoryModel::booksReset() {
+    // Titles and statuses are looked up by book ID, which may now be a different book or none
+    if (loadedRows > 0) emit dataChanged(index(0, TitleColumn), index(loadedRows - 1, StatusColumn));
+}
+
+void TransactionHistoryModel::transactionAppended(const std::size_t row) {
+    // Not sorted in, it goes at the end until the next sort. canFetchMore() picks it up.
+    if (!order.empty()) order.push_back(static_cast<std::uint32_t>(row));
+}
+
+void TransactionHistoryModel::transactionsReset() {
+    // Nothing in order or past the new end means anything anymore
+    beginResetModel();
+    order.clear();
+    loadedRows = static_cast<int>(std::min<std::size_t>(PAGE_SIZE, library->getTransactions().size()));
+    endResetModel();
+}
\ No newline at end of file
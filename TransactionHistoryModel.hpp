@@ -0,0 +1,51 @@
+#ifndef TRANSACTIONHISTORYMODEL_H
+#define TRANSACTIONHISTORYMODEL_H
+
+#include <QAbstractTableModel>
+#include <cstdint>
+#include <vector>
+#include "Library.hpp"
+
+// Transaction history for the dialog. Rows are handed to the view a page at a time as it
+// scrolls, the status column is worked out only for rows being painted, and sorting
+// reorders an index array here rather than in a proxy. Follows the Library while open, a
+// replica keeps applying changes (and may reload everything) under a modal dialog.
+class TransactionHistoryModel : public QAbstractTableModel, public LibraryListener
+{
+    Q_OBJECT
+
+public:
+    enum Column { DateColumn, PatronColumn, TypeColumn, TitleColumn, StatusColumn, ColumnCount };
+
+    explicit TransactionHistoryModel(Library* lib, QObject* parent = nullptr);
+    ~TransactionHistoryModel() override;
+
+    [[nodiscard]] int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    [[nodiscard]] int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    [[nodiscard]] QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    [[nodiscard]] bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // LibraryListener
+    void booksReset() override;
+    void transactionAppended(std::size_t row) override;
+    void transactionsReset() override;
+
+private:
+    static constexpr int PAGE_SIZE = 500;
+
+    enum class Status { Completed, Returned, Active, Overdue };
+
+    Library* library;
+    std::vector<std::uint32_t> order;  // View row -> transaction index, empty means log order
+    int loadedRows = 0;
+
+    [[nodiscard]] const Transaction& transactionAt(int row) const;
+    [[nodiscard]] Status statusOf(const Transaction& t) const;
+    [[nodiscard]] QString statusText(const Transaction& t) const;
+};
+
+#endif
\ No newline at end of file
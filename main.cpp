@@ -1,22 +1,38 @@
 #include <QApplication>
 #include <QIcon>
+#include <QString>
 #include "MainWindow.hpp"
 #include "Library.hpp"
+#include "Stats/Trace.hpp"
 
 int main(int argc, char *argv[]) {
+    // LIBRARY_TRACE=path or --trace[=path] records a timeline of startup, saves and searches
+    Trace::configure(argc, argv);
+
     QApplication app(argc, argv);
 
     app.setWindowIcon(QIcon(":/app_icon.ico"));
 
     Library library;
-    try {
-        library.loadData();
-    } catch (const std::exception& e) {
-        std::cout << e.what() << std::endl;
+
+    // --ship-to=<dir> makes this desk a primary for read-only terminals started with --replica=<dir>
+    QString shipTo, replicaOf;
+    for (const QString& arg : QApplication::arguments()) {
+        if (arg.startsWith("--ship-to=")) shipTo = arg.mid(10);
+        else if (arg.startsWith("--replica=")) replicaOf = arg.mid(10);
     }
 
+    // Window first, the catalog fills in behind it
     MainWindow window(&library);
     window.show();
+    if (!replicaOf.isEmpty()) {
+        window.followPrimary(replicaOf);
+    } else {
+        if (!shipTo.isEmpty()) window.shipChangesTo(shipTo);
+        window.loadCatalogInBackground();
+    }
 
-    return QApplication::exec();
+    const int result = QApplication::exec();
+    Trace::stop();
+    return result;
 }
\ No newline at end of file
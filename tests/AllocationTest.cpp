@@ -0,0 +1,86 @@
+#include <cstdlib>
+#include <new>
+#include "Library.hpp"
+#include "Check.hpp"
+
+// Every heap allocation in the process goes through here
+namespace {
+    std::size_t allocations = 0;
+    std::size_t allocatedBytes = 0;
+}
+
+void* operator new(const std::size_t size) {
+    ++allocations;
+    allocatedBytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    Library library;
+    library.loadData();
+    library.ensureTransactionsLoaded();
+
+    const int patronId = library.getPatrons().front().getId();
+    std::string title;
+    for (const Book* book : library.getBooks()) {
+        if (book->getStatus() == Book::BookStatus::Available) {
+            title = book->getTitle();
+            break;
+        }
+    }
+    CHECK(!title.empty());
+
+    // First time round fills in per-patron and per-title statistics, after that it's steady state
+    for (int i = 0; i < 64; ++i) {
+        library.checkoutBook(patronId, title);
+        library.returnBook(patronId, title);
+    }
+
+    constexpr int CYCLES = 1000;
+    const std::size_t transactionsBefore = library.getTransactions().size();
+    const Memory::Snapshot poolsBefore = Memory::collect();
+    const std::size_t allocationsBefore = allocations;
+    const std::size_t bytesBefore = allocatedBytes;
+
+    for (int i = 0; i < CYCLES; ++i) {
+        library.checkoutBook(patronId, title);
+        library.returnBook(patronId, title);
+    }
+
+    const std::size_t newAllocations = allocations - allocationsBefore;
+    const std::size_t newBytes = allocatedBytes - bytesBefore;
+    const Memory::Snapshot poolsAfter = Memory::collect();
+    const std::size_t appended = library.getTransactions().size() - transactionsBefore;
+    CHECK(appended == 2 * CYCLES);
+
+    // The only thing allowed to allocate is the transaction log growing
+    const Memory::Usage transactionsGrowth{
+        poolsAfter[Memory::Pool::Transactions].bytes - poolsBefore[Memory::Pool::Transactions].bytes,
+        poolsAfter[Memory::Pool::Transactions].blocks - poolsBefore[Memory::Pool::Transactions].blocks
+    };
+    std::cout << CYCLES << " checkout/return cycles: " << newAllocations << " allocations, " << newBytes << " bytes, "
+              << transactionsGrowth.blocks << " blocks / " << transactionsGrowth.bytes << " bytes of it in the transaction log" << std::endl;
+
+    for (std::size_t p = 0; p < Memory::POOL_COUNT; ++p) {
+        const auto pool = static_cast<Memory::Pool>(p);
+        if (pool == Memory::Pool::Transactions) continue;
+        if (poolsAfter[pool].bytes != poolsBefore[pool].bytes) {
+            std::cerr << Memory::poolName(pool) << " pool changed by "
+                      << static_cast<long long>(poolsAfter[pool].bytes - poolsBefore[pool].bytes) << " bytes" << std::endl;
+        }
+        CHECK(poolsAfter[pool].bytes == poolsBefore[pool].bytes);
+    }
+
+    // Each new chunk is two blocks (the chunk and its shared_ptr control block)
+    const std::size_t chunksAdded = (transactionsBefore + appended + 63) / 64 - (transactionsBefore + 63) / 64;
+    CHECK(transactionsGrowth.blocks == 2 * chunksAdded);
+
+    // Anything else has to be the chunk table doubling, which frees the old table so it doesn't stay in the pool
+    CHECK(newAllocations >= transactionsGrowth.blocks);
+    CHECK(newAllocations - transactionsGrowth.blocks <= 8);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef FINAL_PROJECT_CHECK_HPP
+#define FINAL_PROJECT_CHECK_HPP
+
+#include <cstdlib>
+#include <iostream>
+
+// assert() that stays on in release builds, the benchmarks are built optimised
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            std::exit(1); \
+        } \
+    } while (false)
+
+#endif
\ No newline at end of file
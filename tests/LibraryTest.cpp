@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "Library.hpp"
+#include "Index/RankedSearch.hpp"
+#include "Stats/CoBorrowIndex.hpp"
+#include "Check.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+    std::string savedLineOf(const Book& book, const std::string& directory) {
+        std::ifstream file(directory + "/Books.txt");
+        const std::string suffix = "|" + std::to_string(book.getId());
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.ends_with(suffix) && line.find("|" + book.getTitle() + "|") != std::string::npos) return line;
+        }
+        return {};
+    }
+
+    // A returned book forgets when it went out and when it was due, in memory and on disk
+    void returnClearsDates() {
+        Book book("Title", "Author", Book::Genre::Fiction);
+        book.checkout(3, Date(1, 2, 2025));
+        CHECK(book.getCheckoutDate() == Date(1, 2, 2025) && book.getDueDate() == Date(3, 3, 2025));
+        book.returnBook();
+        CHECK(book.getStatus() == Book::BookStatus::Available);
+        CHECK(!book.getCheckoutDate() && !book.getDueDate() && !book.getCurrentPatronId());
+
+        Library library;
+        library.loadData();
+        library.ensureTransactionsLoaded();
+        const int patronId = library.getPatrons().front().getId();
+        const Book* lent = nullptr;
+        for (const Book* b : library.getBooks()) {
+            if (b->getStatus() == Book::BookStatus::Available) {
+                lent = b;
+                break;
+            }
+        }
+        CHECK(lent);
+        library.checkoutBook(patronId, lent->getTitle());
+        library.returnBook(patronId, lent->getTitle());
+        CHECK(!lent->getCheckoutDate() && !lent->getDueDate());
+
+        fs::remove_all("LibrarySaved");
+        fs::create_directories("LibrarySaved");
+        CHECK(Library::saveSnapshot(*library.snapshot(), "LibrarySaved"));
+        const std::string line = savedLineOf(*lent, "LibrarySaved");
+        CHECK(line.ends_with("|Available|null|null|null|" + std::to_string(lent->getId())));
+    }
+
+    // A line without an ID takes the next free one, a later line claiming that ID is dropped rather than shadowing it
+    void duplicateIdsOnLoad() {
+        fs::create_directories("LibraryDuplicates");
+        {
+            std::ofstream file("LibraryDuplicates/Books.txt");
+            file << "Fiction|Legacy|Writer|PrintedBook|100|Available|null|null|null\n"
+                 << "Mystery|Claims The Same ID|Writer|PrintedBook|100|Available|null|null|null|500\n"
+                 << "Science|Other|Writer|PrintedBook|100|Available|null|null|null|7\n";
+        }
+        Book::resetIdCounter(500);
+        Library library;
+        library.loadBooks("LibraryDuplicates/Books.txt");
+        CHECK(library.getBooks().size() == 2);
+        CHECK(library.findBookById(500)->getTitle() == "Legacy");
+        CHECK(library.findBookById(7)->getTitle() == "Other");
+        CHECK(!library.findBook("Claims The Same ID"));
+
+        // Same for the batches the background loader hands over
+        library.beginLoading();
+        library.appendBooks({new Book("First", "Writer", Book::Genre::Fiction), new Book("Second", "Writer", Book::Genre::Fiction)});
+        Book* duplicate = new Book("Third", "Writer", Book::Genre::Fiction);
+        duplicate->setId(library.getBooks().front()->getId());
+        library.appendBooks({duplicate});
+        CHECK(library.getBooks().size() == 2);
+        CHECK(!library.findBook("Third"));
+    }
+
+    // The worker's typo-tolerant search reads the snapshot's trigram index, which later additions don't touch
+    void fuzzySearchOnSnapshot() {
+        Library library;
+        library.loadData();
+        const auto before = library.snapshot();
+        CHECK(before->fuzzyTitles && before->fuzzyAuthors);
+
+        const auto hobbit = fuzzySearch(*before, SearchField::Title, "the hobit", 10);
+        CHECK(!hobbit.empty() && library.findBookById(hobbit.front())->getTitle() == "The Hobbit");
+        CHECK(fuzzySearch(*before, SearchField::Title, "quixotik zebra", 10).empty());
+
+        library.addBook(new PrintedBook("Quixotic Zebra", "Writer", Book::Genre::Fiction, 100));
+        CHECK(fuzzySearch(*before, SearchField::Title, "quixotik zebra", 10).empty());
+        CHECK(fuzzySearch(*library.snapshot(), SearchField::Title, "quixotik zebra", 10).size() == 1);
+    }
+
+    // A full co-borrowing row loses one of its weakest pairs to a newcomer, not all of them
+    void coBorrowRowEviction() {
+        CoBorrowIndex index;
+        // Two patrons borrow titles 1 and 2, then each of the rest borrows title 1 and a title nobody else does
+        index.recordCheckout(0, 1);
+        index.recordCheckout(0, 2);
+        index.recordCheckout(1000, 1);
+        index.recordCheckout(1000, 2);
+        for (int patron = 1; patron < static_cast<int>(CoBorrowIndex::MAX_ROW) + 10; ++patron) {
+            index.recordCheckout(patron, 1);
+            index.recordCheckout(patron, 100 + patron);
+        }
+
+        const auto similar = index.similar(1, CoBorrowIndex::MAX_ROW);
+        CHECK(similar.size() == CoBorrowIndex::MAX_ROW);
+        CHECK(similar.front() == 2);
+        const int newest = 100 + static_cast<int>(CoBorrowIndex::MAX_ROW) + 9;
+        CHECK(std::ranges::find(similar, newest) != similar.end());
+        CHECK(std::ranges::find(similar, 101) == similar.end());  // The oldest of the weakest went first
+    }
+
+    // Copies of one title count as that title, once, in the circulation figures
+    void circulationByTitle() {
+        Library library;
+        library.loadData();
+        library.ensureTransactionsLoaded();
+        Book* first = new PrintedBook("Popular Title", "Writer", Book::Genre::Fiction, 100);
+        library.addBook(first);
+        library.addBook(new PrintedBook("Popular Title", "Writer", Book::Genre::Fiction, 100));
+
+        const auto& patrons = library.getPatrons();
+        CHECK(patrons.size() >= 2);
+        for (int round = 0; round < 20; ++round) {
+            library.checkoutBook(patrons[0].getId(), "Popular Title");
+            library.checkoutBook(patrons[1].getId(), "Popular Title");
+            library.returnBook(patrons[0].getId(), "Popular Title");
+            library.returnBook(patrons[1].getId(), "Popular Title");
+        }
+
+        const auto checkTitleCounts = [&]() {
+            const auto& stats = library.circulationStats();
+            CHECK(stats.timesBorrowed(first->getId()) >= 40);
+            CHECK(stats.mostBorrowed().front().titleId == first->getId());
+            CHECK(std::ranges::count_if(stats.mostBorrowed(), [&](const BorrowCount& entry) {
+                const Book* book = library.findBookById(entry.titleId);
+                return book && book->getTitle() == "Popular Title";
+            }) == 1);
+        };
+        checkTitleCounts();
+
+        // Replaying the log when it's read back counts the same way
+        fs::remove_all("LibraryCirculation");
+        fs::create_directories("LibraryCirculation");
+        CHECK(Library::saveSnapshot(*library.snapshot(), "LibraryCirculation"));
+        library.loadTransactions("LibraryCirculation/Transactions.bin");
+        checkTitleCounts();
+    }
+}
+
+int main() {
+    returnClearsDates();
+    duplicateIdsOnLoad();
+    fuzzySearchOnSnapshot();
+    coBorrowRowEviction();
+    circulationByTitle();
+    return 0;
+}
\ No newline at end of file
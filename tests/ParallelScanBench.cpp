@@ -0,0 +1,61 @@
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <set>
+#include "Library.hpp"
+#include "Stats/ParallelScan.hpp"
+#include "Stats/Reports.hpp"
+#include "Check.hpp"
+
+int main() {
+    constexpr int TRANSACTIONS = 5000000;
+
+    Library library;
+    library.loadData();
+
+    // Years of made-up history on top of the real catalog, a few hundred transactions a day
+    CatalogSnapshot snapshot = *library.snapshot();
+    const auto bookCount = static_cast<unsigned>(snapshot.books.size());
+    std::mt19937 rng(39);
+    int day = Date(1, 1, 2010).toDayNumber();
+    for (int i = 0; i < TRANSACTIONS; ++i) {
+        if (rng() % 400 == 0) ++day;
+        const int bookId = snapshot.books[rng() % bookCount].id;
+        const auto type = rng() % 2 ? TransactionType::Checkout : TransactionType::Return;
+        snapshot.transactions.emplace_back(1 + static_cast<int>(rng() % 2000), bookId, type, Date::fromDayNumber(day));
+    }
+
+    std::set<unsigned> threadCounts{1, 2, 4, 8, scanThreads()};
+    std::cout << snapshot.transactions.size() << " transactions, " << scanThreads() << " hardware threads" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(14) << "trends ms" << std::setw(14) << "frequency ms" << std::setw(10) << "speedup" << std::endl;
+
+    // Best of three, in milliseconds
+    auto timeIt = [](auto&& run) {
+        double best = 1e300;
+        for (int i = 0; i < 3; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    };
+
+    const auto expectedTrends = Reports::genreTrendsByMonth(snapshot, 1);
+    const auto expectedFrequency = Reports::borrowingFrequency(snapshot, 1);
+    CHECK(!expectedTrends.empty() && !expectedFrequency.empty());
+
+    double serial = 0;
+    for (const unsigned threads : threadCounts) {
+        // Same answer however the history is split up
+        CHECK(Reports::genreTrendsByMonth(snapshot, threads) == expectedTrends);
+        CHECK(Reports::borrowingFrequency(snapshot, threads) == expectedFrequency);
+
+        const double trends = timeIt([&]() { return Reports::genreTrendsByMonth(snapshot, threads); });
+        const double frequency = timeIt([&]() { return Reports::borrowingFrequency(snapshot, threads); });
+        if (threads == 1) serial = trends + frequency;
+
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(1) << std::setw(14) << trends
+                  << std::setw(14) << frequency << std::setw(9) << serial / (trends + frequency) << "x" << std::endl;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include "Library.hpp"
+#include "Index/Query.hpp"
+#include "Check.hpp"
+
+namespace {
+    // What the planner has to agree with: every predicate checked on every book, no indexes
+    bool naiveMatch(const Query& q, const Book& book) {
+        switch (q.kind) {
+            case Query::Kind::TitleContains: return foldCase(book.getTitle()).find(q.text) != std::string::npos;
+            case Query::Kind::AuthorContains: return foldCase(book.getAuthor()).find(q.text) != std::string::npos;
+            case Query::Kind::GenreIs: return book.getGenre() == q.genre;
+            case Query::Kind::StatusIs: return book.getStatus() == q.status;
+            case Query::Kind::TypeIs: return BookIndexes::kindOf(book) == q.type;
+            case Query::Kind::Overdue: return book.isOverdue();
+            case Query::Kind::DueBefore:
+                return book.getStatus() == Book::BookStatus::CheckedOut && book.getDueDate()
+                    && book.getDueDate()->toDayNumber() < q.dayNumber;
+            case Query::Kind::All:
+                return std::ranges::all_of(q.children, [&](const Query& c) { return naiveMatch(c, book); });
+            case Query::Kind::Any:
+                return std::ranges::any_of(q.children, [&](const Query& c) { return naiveMatch(c, book); });
+        }
+        return false;
+    }
+
+    std::vector<Book*> naiveQuery(const Library& library, const Query& q) {
+        std::vector<Book*> results;
+        for (Book* book : library.getBooks()) {
+            if (naiveMatch(q, *book)) results.push_back(book);
+        }
+        return results;
+    }
+
+    // Best of a few runs, in microseconds
+    double timeIt(const std::function<std::size_t()>& run) {
+        double best = 1e300;
+        for (int i = 0; i < 5; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            volatile std::size_t sink = run();
+            (void)sink;
+            best = std::min(best, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    }
+}
+
+int main() {
+    constexpr int BOOKS = 200000;
+
+    Library library;
+    library.loadData();
+
+    // A catalog big enough for the difference to show: mixed types and genres, ~5% out, a fifth of those late
+    std::mt19937 rng(34);
+    const int today = Date().toDayNumber();
+    const int patronId = library.getPatrons().front().getId();
+    std::streambuf* console = std::cout.rdbuf(nullptr);  // addBook() announces every book
+    for (int i = 0; i < BOOKS; ++i) {
+        const auto genre = static_cast<Book::Genre>(rng() % 5);
+        const std::string title = "Title " + std::to_string(i) + (i % 97 == 0 ? " Dragon" : "");
+        const std::string author = "Author " + std::to_string(rng() % 5000);
+
+        Book* book = nullptr;
+        switch (rng() % 3) {
+            case 0: book = new EBook(title, author, genre, 1.0 + i % 50); break;
+            case 1: book = new PrintedBook(title, author, genre, 100 + i % 900); break;
+            default: book = new Book(title, author, genre); break;
+        }
+        if (rng() % 20 == 0) {
+            const int due = today - 10 + static_cast<int>(rng() % 50);
+            book->setStatus(Book::BookStatus::CheckedOut);
+            book->setCheckoutDate(Date::fromDayNumber(due - 14));
+            book->setDueDate(Date::fromDayNumber(due));
+            book->setCurrentPatronId(patronId);
+        }
+        library.addBook(book);
+    }
+    std::cout.rdbuf(console);
+    std::cout.clear();
+
+    const std::pair<const char*, Query> queries[] = {
+        {"mystery && overdue", Query::genreIs(Book::Genre::Mystery) && Query::overdue()},
+        {"ebook && checked out && science", Query::typeIs(BookKind::EBook) && Query::statusIs(Book::BookStatus::CheckedOut)
+            && Query::genreIs(Book::Genre::Science)},
+        {"title 'dragon' && printed", Query::titleContains("dragon") && Query::typeIs(BookKind::Printed)},
+        {"due within a week || overdue", Query::dueBefore(Date::fromDayNumber(today + 7)) || Query::overdue()},
+        {"author 'author 42' && available", Query::authorContains("author 42") && Query::statusIs(Book::BookStatus::Available)},
+        {"fiction || biography", Query::genreIs(Book::Genre::Fiction) || Query::genreIs(Book::Genre::Biography)},
+    };
+
+    std::cout << library.getBooks().size() << " books" << std::endl;
+    std::cout << std::left << std::setw(36) << "query" << std::right << std::setw(10) << "matches"
+              << std::setw(14) << "planned us" << std::setw(14) << "naive us" << std::setw(10) << "speedup" << std::endl;
+
+    for (const auto& [name, q] : queries) {
+        const auto planned = library.query(q);
+        const auto naive = naiveQuery(library, q);
+        if (planned != naive) std::cerr << name << ": planner found " << planned.size() << ", scan found " << naive.size() << std::endl;
+        CHECK(planned == naive);
+
+        const double plannedTime = timeIt([&]() { return library.query(q).size(); });
+        const double naiveTime = timeIt([&]() { return naiveQuery(library, q).size(); });
+        std::cout << std::left << std::setw(36) << name << std::right << std::setw(10) << planned.size()
+                  << std::setw(14) << std::fixed << std::setprecision(0) << plannedTime << std::setw(14) << naiveTime
+                  << std::setw(9) << std::setprecision(1) << naiveTime / plannedTime << "x" << std::endl;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "RecordFormats.hpp"
+#include "Transaction/Transaction.hpp"
+#include "Check.hpp"
+
+namespace {
+    std::vector<std::string> readLines(const std::string& filename) {
+        std::ifstream file(filename);
+        CHECK(file.is_open());
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty()) lines.push_back(line);
+        }
+        return lines;
+    }
+
+    // Text -> fields -> text and fields -> binary -> fields -> text, both must give the line back
+    template<typename Schema, typename Record>
+    void checkRoundTrip(const std::vector<std::string>& lines) {
+        std::string text;
+        std::string binary;
+        for (const auto& line : lines) {
+            Record fields;
+            Schema::parseText(line, fields);
+            text.clear();
+            Schema::formatText(fields, text);
+            if (text != line) std::cerr << "'" << line << "' came back as '" << text << "'" << std::endl;
+            CHECK(text == line);
+
+            binary.clear();
+            Schema::encodeBinary(fields, binary);
+            Record decoded;
+            std::string_view in = binary;
+            Schema::decodeBinary(in, decoded);
+            CHECK(in.empty());
+            text.clear();
+            Schema::formatText(decoded, text);
+            CHECK(text == line);
+        }
+    }
+
+    // What Library.cpp did before the schemas, kept here to measure against
+    struct HandwrittenBook {
+        std::string genre, title, author, type, extra, status, checkoutDate, dueDate, patronId, id;
+    };
+
+    HandwrittenBook parseHandwritten(const std::string& line) {
+        std::stringstream ss(line);
+        HandwrittenBook b;
+        std::getline(ss, b.genre, '|');
+        std::getline(ss, b.title, '|');
+        std::getline(ss, b.author, '|');
+        std::getline(ss, b.type, '|');
+        std::getline(ss, b.extra, '|');
+        std::getline(ss, b.status, '|');
+        std::getline(ss, b.checkoutDate, '|');
+        std::getline(ss, b.dueDate, '|');
+        std::getline(ss, b.patronId, '|');
+        std::getline(ss, b.id, '|');
+
+        volatile int sink = static_cast<int>(Book::stringToGenre(b.genre));
+        sink = b.type == "EBook" ? static_cast<int>(std::stod(b.extra)) : std::stoi(b.extra);
+        if (b.checkoutDate != "null") {
+            int d, m, y;
+            char delim;
+            std::stringstream ds(b.checkoutDate);
+            ds >> d >> delim >> m >> delim >> y;
+            sink = Date(d, m, y).toDayNumber();
+        }
+        if (b.patronId != "null") sink = std::stoi(b.patronId);
+        sink = std::stoi(b.id);
+        (void)sink;
+        return b;
+    }
+
+    std::string formatHandwritten(const BookLine& b) {
+        std::string result = std::string(Book::genreToString(b.genre)) + "|" + std::string(b.title) + "|" + std::string(b.author) + "|";
+        result += std::string(b.type) + "|" + std::string(b.extra) + "|";
+        result += b.status.value == Book::BookStatus::CheckedOut ? "CheckedOut|" : "Available|";
+        result += (b.checkoutDate.value ? b.checkoutDate.value->toString() : "null") + "|";
+        result += (b.dueDate.value ? b.dueDate.value->toString() : "null") + "|";
+        result += (b.patronId.value ? std::to_string(*b.patronId.value) : "null") + "|";
+        result += std::to_string(*b.id);
+        return result;
+    }
+
+    // Nanoseconds per line, best of three
+    template<typename Run>
+    double nsPerLine(const std::size_t lines, Run run) {
+        double best = 1e300;
+        for (int i = 0; i < 3; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            best = std::min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best / static_cast<double>(lines);
+    }
+}
+
+int main() {
+    // The files that ship with the program read and write back byte for byte
+    checkRoundTrip<BookSchema, BookLine>(readLines("Data/Books.txt"));
+    checkRoundTrip<PatronSchema, PatronLine>(readLines("Data/Patrons.txt"));
+    checkRoundTrip<TransactionTextSchema, TransactionLine>(readLines("Data/Transactions.txt"));
+    checkRoundTrip<HoldSchema, HoldLine>({"1|The Hobbit", "12|Dune"});
+
+    // Hand-edited spellings the old stream parsers took
+    {
+        BookLine fields;
+        BookSchema::parseText("Non-Fiction|T|A|EBook|1.5|CheckedOut|1-2-2024| 15 / 2 / 2024 |7|11\r", fields);
+        CHECK(fields.genre == Book::Genre::NonFiction && fields.status.value == Book::BookStatus::CheckedOut);
+        CHECK(fields.checkoutDate.value == Date(1, 2, 2024) && fields.dueDate.value == Date(15, 2, 2024));
+        CHECK(fields.patronId.value == 7 && fields.id == 11);
+
+        BookSchema::parseText("NonFiction|T|A|Book|0|Checked Out|??|never|x", fields);
+        CHECK(fields.genre == Book::Genre::NonFiction && !fields.status.value && !fields.checkoutDate.value && !fields.patronId.value);
+        CHECK(!fields.id);
+
+        BookSchema::parseText("Fiction|T|A|PrintedBook|100", fields);
+        CHECK(!fields.status.value && !fields.dueDate.value && !fields.id);
+
+        bool threw = false;
+        try {
+            BookSchema::parseText("Poetry|T|A|PrintedBook|100", fields);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        CHECK(threw);
+
+        TransactionLine transaction;
+        TransactionTextSchema::parseText("3|Dune|checked out.|5.6.2025", transaction);
+        CHECK(transaction.patronId == 3 && transaction.date == Date(5, 6, 2025));
+        CHECK(Transaction::stringToType(std::string(transaction.type)) == TransactionType::Checkout);
+    }
+
+    // Throughput on a big generated Books.txt, against the handwritten code the schemas replaced
+    constexpr int LINES = 200000;
+    std::vector<std::string> lines;
+    lines.reserve(LINES);
+    for (int i = 0; i < LINES; ++i) {
+        BookLine b;
+        b.genre = static_cast<Book::Genre>(i % 5);
+        const std::string title = "Synthetic Title " + std::to_string(i);
+        const std::string extra = i % 2 ? std::to_string(100 + i % 900) : "2.500000";
+        b.title = title;
+        b.author = "Author Name";
+        b.type = i % 2 ? "PrintedBook" : "EBook";
+        b.extra = extra;
+        b.status.value = i % 10 == 0 ? Book::BookStatus::CheckedOut : Book::BookStatus::Available;
+        if (i % 10 == 0) {
+            b.checkoutDate.value = Date(1, 1 + i % 12, 2025);
+            b.dueDate.value = Date(15, 1 + i % 12, 2025);
+            b.patronId.value = i % 50;
+        }
+        b.id = i + 1;
+        std::string line;
+        BookSchema::formatText(b, line);
+        lines.push_back(std::move(line));
+    }
+
+    std::vector<BookLine> parsed(lines.size());
+    const double schemaParse = nsPerLine(lines.size(), [&]() {
+        for (std::size_t i = 0; i < lines.size(); ++i) BookSchema::parseText(lines[i], parsed[i]);
+    });
+    const double handwrittenParse = nsPerLine(lines.size(), [&]() {
+        for (const auto& line : lines) parseHandwritten(line);
+    });
+
+    std::size_t bytes = 0;
+    std::string buffer;
+    const double schemaFormat = nsPerLine(lines.size(), [&]() {
+        for (const auto& b : parsed) {
+            buffer.clear();
+            BookSchema::formatText(b, buffer);
+            bytes += buffer.size();
+        }
+    });
+    const double handwrittenFormat = nsPerLine(lines.size(), [&]() {
+        for (const auto& b : parsed) bytes += formatHandwritten(b).size();
+    });
+    for (std::size_t i = 0; i < lines.size(); i += 997) CHECK(formatHandwritten(parsed[i]) == lines[i]);
+
+    std::string binary;
+    const double encode = nsPerLine(lines.size(), [&]() {
+        binary.clear();
+        for (const auto& b : parsed) BookSchema::encodeBinary(b, binary);
+    });
+    const double decode = nsPerLine(lines.size(), [&]() {
+        std::string_view in = binary;
+        BookLine b;
+        while (!in.empty()) BookSchema::decodeBinary(in, b);
+    });
+
+    std::cout << std::fixed << std::setprecision(0) << LINES << " Books.txt lines, ns per line:" << std::endl
+              << "  text parse   schema " << std::setw(5) << schemaParse << "   handwritten " << std::setw(5) << handwrittenParse << std::endl
+              << "  text format  schema " << std::setw(5) << schemaFormat << "   handwritten " << std::setw(5) << handwrittenFormat << std::endl
+              << "  binary       encode " << std::setw(5) << encode << "   decode " << std::setw(5) << decode
+              << "   (" << binary.size() / LINES << " bytes per record)" << std::endl;
+
+    CHECK(schemaParse <= handwrittenParse);
+    CHECK(schemaFormat <= handwrittenFormat);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Library.hpp"
+#include "Replication/Replica.hpp"
+#include "Check.hpp"
+
+namespace fs = std::filesystem;
+
+// Book and patron IDs come from static counters, so every replica gets a process of its own
+namespace {
+    const std::string SHIP = "ReplicaShipping/Ship";
+    constexpr std::int64_t MAX_LAG_MILLIS = 2000;  // Polled every 20 ms, anything near this is a stall
+
+    std::string readFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    std::string availableTitle(const Library& library) {
+        for (const Book* book : library.getBooks()) {
+            if (book->getStatus() == Book::BookStatus::Available) return book->getTitle();
+        }
+        return {};
+    }
+
+    // Follows SHIP until it has applied the sequence the primary leaves in SHIP/done, then saves what it has
+    [[noreturn]] void runReplica() {
+        Library library;
+        Replication::Replica replica(library, SHIP);
+        std::uint64_t target = 0;
+        while (!target || replica.appliedSequence() < target) {
+            replica.poll();
+            if (!target && fs::exists(SHIP + "/done")) {
+                std::ifstream in(SHIP + "/done");
+                in >> target;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        bool threw = false;
+        try {
+            library.checkoutBook(library.getPatrons().front().getId(), availableTitle(library));
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        CHECK(threw);
+
+        fs::create_directories("ReplicaShipping/Replica");
+        CHECK(Library::saveSnapshot(*library.snapshot(), "ReplicaShipping/Replica"));
+        std::cout << "Replica applied " << replica.appliedSequence() << " changes, lag " << replica.lastLagMillis()
+                  << " ms at the end, " << replica.maxLagMillis() << " ms at worst" << std::endl;
+        CHECK(replica.maxLagMillis() < MAX_LAG_MILLIS);
+        std::exit(0);
+    }
+
+    // A primary doing random writes, re-based halfway through, must end up identical to a replica that followed it
+    void convergence() {
+        fs::remove_all("ReplicaShipping");
+        fs::create_directories(SHIP);
+        std::cout.flush();
+        const pid_t child = fork();
+        CHECK(child >= 0);
+        if (child == 0) runReplica();
+
+        Library library;
+        library.loadData();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Replica is up before there's anything to read
+        library.shipChangesTo(SHIP);
+
+        std::mt19937 rng(7);
+        const auto& books = library.getBooks();
+        std::size_t writes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 3000; ++i) {
+            const auto& patrons = library.getPatrons();
+            const int patronId = patrons[rng() % patrons.size()].getId();
+            const Book* book = books[rng() % books.size()];
+            try {
+                switch (rng() % 6) {
+                    case 0: case 1:
+                        library.checkoutBook(patronId, book->getTitle());
+                        break;
+                    case 2: case 3:
+                        if (book->getCurrentPatronId()) library.returnBook(*book->getCurrentPatronId(), book->getTitle());
+                        break;
+                    case 4:
+                        library.placeHold(patronId, book->getTitle());
+                        break;
+                    default:
+                        if (i % 30 == 5) library.addBook(new PrintedBook("Added " + std::to_string(i), "Writer", Book::Genre::Mystery, 100 + i));
+                        else if (i % 30 == 11) library.addPatron(Patron("Patron " + std::to_string(i)));
+                        break;
+                }
+                ++writes;
+            } catch (const std::exception&) {
+                // Unknown titles, books already out and so on, the replica has to agree on those too
+            }
+            if (i == 1500) library.shipChangesTo(SHIP);  // Like the primary restarting
+            if (i % 100 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::uint64_t last = 0;
+        {
+            Replication::ChangeLogReader reader(SHIP);
+            reader.reset(*reader.currentEpoch());
+            reader.poll([&](const Replication::Change& change) { last = change.sequence; });
+        }
+        CHECK(last > 0);
+        {
+            std::ofstream out(SHIP + "/done");
+            out << last;
+        }
+        fs::create_directories("ReplicaShipping/Primary");
+        CHECK(Library::saveSnapshot(*library.snapshot(), "ReplicaShipping/Primary"));
+
+        int status = 0;
+        waitpid(child, &status, 0);
+        std::cout << "Primary made " << writes << " writes (" << last << " logged since the re-base) in " << elapsed << " ms" << std::endl;
+        CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+        for (const char* file : {"Books.txt", "Patrons.txt", "Holds.txt", "Transactions.bin"}) {
+            const std::string primary = readFile(std::string("ReplicaShipping/Primary/") + file);
+            const std::string replica = readFile(std::string("ReplicaShipping/Replica/") + file);
+            if (primary != replica) std::cerr << file << " differs between primary and replica" << std::endl;
+            CHECK(primary == replica);
+        }
+    }
+
+    void limitFileSize(const rlim_t bytes) {
+        const rlimit limit{bytes, RLIM_INFINITY};
+        setrlimit(RLIMIT_FSIZE, &limit);
+    }
+
+    // The change log can't grow (disk full): writes carry on, and the next change that can be logged re-bases the replicas
+    [[noreturn]] void runFullDisk() {
+        std::signal(SIGXFSZ, SIG_IGN);
+        Library library;
+        library.loadData();
+        library.ensureTransactionsLoaded();
+        fs::remove_all(SHIP);
+        library.shipChangesTo(SHIP);
+
+        const int patronId = library.getPatrons().front().getId();
+        const std::string first = availableTitle(library);
+        library.checkoutBook(patronId, first);
+
+        limitFileSize(fs::file_size(Replication::logPath(SHIP)));
+        const std::string second = availableTitle(library);
+        library.checkoutBook(patronId, second);
+        CHECK(library.findBook(second)->getStatus() == Book::BookStatus::CheckedOut);
+        CHECK(library.isShipping() && !fs::exists(Replication::logPath(SHIP)));
+
+        limitFileSize(RLIM_INFINITY);
+        library.returnBook(patronId, first);
+        CHECK(fs::exists(Replication::logPath(SHIP)));
+
+        Library copy;
+        Replication::Replica replica(copy, SHIP);
+        replica.poll();
+        CHECK(replica.isReady());
+        CHECK(copy.findBook(second)->getStatus() == Book::BookStatus::CheckedOut);
+        CHECK(copy.findBook(first)->getStatus() == Book::BookStatus::Available);
+        std::exit(0);
+    }
+
+    void fullDisk() {
+        std::cout.flush();
+        const pid_t child = fork();
+        CHECK(child >= 0);
+        if (child == 0) runFullDisk();
+        int status = 0;
+        waitpid(child, &status, 0);
+        CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    // A record that won't decode stops the replica where it was, and it stays put (no reloading Base/
+    // on every poll) until the primary starts a new epoch
+    [[noreturn]] void runBrokenRecord() {
+        Library library;
+        library.loadData();
+        library.ensureTransactionsLoaded();
+        fs::remove_all(SHIP);
+        library.shipChangesTo(SHIP);
+
+        const int patronId = library.getPatrons().front().getId();
+        const std::string first = availableTitle(library);
+        library.checkoutBook(patronId, first);
+        {
+            std::ofstream log(Replication::logPath(SHIP), std::ios::binary | std::ios::app);
+            log << '\x02' << "\xff\xff";  // Length prefix is fine, the body isn't a change
+        }
+
+        Library copy;
+        Replication::Replica replica(copy, SHIP);
+        replica.poll();
+        CHECK(!replica.isReady());
+        CHECK(copy.findBook(first)->getStatus() == Book::BookStatus::CheckedOut);
+
+        // Would show up if the replica went back to Base/
+        const std::size_t patronCount = copy.getPatrons().size();
+        {
+            std::ofstream patrons(SHIP + "/Base/Patrons.txt", std::ios::app);
+            patrons << "\n999999|Reload Canary";
+        }
+        for (int i = 0; i < 3; ++i) CHECK(replica.poll() == 0);
+        CHECK(!replica.isReady() && copy.getPatrons().size() == patronCount);
+
+        library.shipChangesTo(SHIP);
+        const std::string second = availableTitle(library);
+        library.checkoutBook(patronId, second);
+        replica.poll();
+        CHECK(replica.isReady() && replica.appliedSequence() == 1);
+        CHECK(copy.getPatrons().size() == library.getPatrons().size());
+        CHECK(copy.findBook(second)->getStatus() == Book::BookStatus::CheckedOut);
+        std::exit(0);
+    }
+
+    void brokenRecord() {
+        std::cout.flush();
+        const pid_t child = fork();
+        CHECK(child >= 0);
+        if (child == 0) runBrokenRecord();
+        int status = 0;
+        waitpid(child, &status, 0);
+        CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+}
+
+int main() {
+    convergence();
+    fullDisk();
+    brokenRecord();
+    return 0;
+}
\ No newline at end of file